@@ -9,6 +9,7 @@
 #include <QskBoxBorderMetrics.h>
 #include <QskBoxShapeMetrics.h>
 #include <QskRgbPalette.h>
+#include <QskShadowMetrics.h>
 
 Box::Box( QQuickItem* parentItem )
     : QskBox( parentItem )
@@ -129,6 +130,12 @@ void Box::setBorderGradient( const QskGradient& gradient )
     setBoxBorderColorsHint( QskBox::Panel, gradient );
 }
 
+void Box::setShadow( const QskShadowMetrics& metrics, const QColor& color )
+{
+    setShadowMetricsHint( QskBox::Panel, metrics );
+    setShadowColorHint( QskBox::Panel, color );
+}
+
 void Box::setBorderWidth( qreal left, qreal top, qreal right, qreal bottom )
 {
     setBoxBorderMetricsHint( QskBox::Panel,
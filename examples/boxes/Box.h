@@ -8,6 +8,8 @@
 #include <QskRgbPalette.h>
 #include <QskBox.h>
 
+class QskShadowMetrics;
+
 class Box : public QskBox
 {
   public:
@@ -43,6 +45,8 @@ class Box : public QskBox
     void setBorderGradients( const QskGradient& left, const QskGradient& top,
         const QskGradient& right, const QskGradient& bottom );
 
+    void setShadow( const QskShadowMetrics&, const QColor& );
+
     void setBorderWidth( int );
     void setBorderWidth( qreal left, qreal top, qreal right, qreal bottom );
 
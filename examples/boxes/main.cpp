@@ -16,6 +16,7 @@
 #include <QskBoxShapeMetrics.h>
 #include <QskGradient.h>
 #include <QskRgbValue.h>
+#include <QskShadowMetrics.h>
 
 #include <QskObjectCounter.h>
 
@@ -453,6 +454,32 @@ static void addColoredBorderRectangles5( QskLinearBox* parent, bool rounded, Box
         box->setShape( { 10, 20, 20, 40 } );
 }
 
+static void addShadowedRectangles( QskLinearBox* parent, bool rounded )
+{
+    const QColor shadowColor( 0, 0, 0, 120 );
+
+    const QskShadowMetrics metrics[ 5 ] =
+    {
+        QskShadowMetrics( 0, 10 ),
+        QskShadowMetrics( 0, 20, QPointF( 10, 10 ) ),
+        QskShadowMetrics( 10, 10 ),
+        QskShadowMetrics( 10, 30, QPointF( -10, 10 ) ),
+        QskShadowMetrics( 20, 0 )
+    };
+
+    for ( const auto& shadow : metrics )
+    {
+        auto box = new Box( parent );
+        box->setMargins( 30 );
+        box->setShadow( shadow, shadowColor );
+        box->setBorder( Box::Flat, QskRgbPalette::Grey );
+        box->setBackground( Box::Solid, QskRgbPalette::Grey );
+
+        if ( rounded )
+            box->setShape( { 10, 20, 30, 40 } );
+    }
+}
+
 class TabView : public QskTabView
 {
   public:
@@ -532,6 +559,12 @@ class TabView : public QskTabView
         addColoredBorderRectangles5( tab5, true, Box::Vertical );
 
         addTab( tab5 );
+
+        auto* tab6 = new QskLinearBox( Qt::Horizontal, 5 );
+        addShadowedRectangles( tab6, false );
+        addShadowedRectangles( tab6, true );
+
+        addTab( tab6 );
     }
 
   private:
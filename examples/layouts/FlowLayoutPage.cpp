@@ -8,17 +8,18 @@
 #include "TestRectangle.h"
 
 #include <QskAspect.h>
+#include <QskFlowBox.h>
 #include <QskLinearBox.h>
 #include <QskRgbValue.h>
 #include <QskTextLabel.h>
 
 namespace
 {
-    class Box : public QskLinearBox
+    class Box : public QskFlowBox
     {
       public:
         Box( QQuickItem* parent = nullptr )
-            : QskLinearBox( Qt::Horizontal, 5, parent )
+            : QskFlowBox( Qt::Horizontal, parent )
         {
             setObjectName( "Box" );
 
@@ -53,32 +54,34 @@ namespace
 
         void rotate()
         {
-            const int index = 0;
-
-            auto item = itemAtIndex( index );
-            removeAt( index );
-
-            if ( item == nullptr )
-            {
-                // how to get the spacer item and its settings ???
-                addSpacer( 30 );
-            }
-            else
-            {
+            if ( auto item = itemAtIndex( 0 ) )
                 addItem( item );
-            }
         }
 
         void incrementDimension( int count )
         {
-            setDimension( dimension() + count );
+            // bigger items result in less items per line
+
+            for ( int i = 0; i < elementCount(); i++ )
+            {
+                if ( auto control = qskControlCast( itemAtIndex( i ) ) )
+                {
+                    auto size = control->preferredSize();
+                    size += QSizeF( 10 * count, 10 * count );
+
+                    control->setPreferredSize( size.expandedTo( QSizeF( 20, 20 ) ) );
+                }
+            }
         }
 
       private:
         void addRectangle( const char* colorName )
         {
+            const int index = elementCount();
+
             auto rect = new TestRectangle( colorName );
-            rect->setText( QString::number( elementCount() + 1 ) );
+            rect->setText( QString::number( index + 1 ) );
+            rect->setPreferredSize( 60 + ( index % 4 ) * 30, 60 + ( index % 3 ) * 15 );
 
             addItem( rect );
         }
@@ -13,6 +13,7 @@
 #include <SkinnyShortcut.h>
 
 #include <QskFocusIndicator.h>
+#include <QskLayoutProfiler.h>
 #include <QskObjectCounter.h>
 #include <QskTabView.h>
 #include <QskWindow.h>
@@ -24,6 +25,9 @@ int main( int argc, char* argv[] )
 {
 #ifdef ITEM_STATISTICS
     QskObjectCounter counter( true );
+#endif
+#ifdef LAYOUT_STATISTICS
+    QskLayoutProfiler profiler( true );
 #endif
     QskQml::registerTypes();
     qmlRegisterType< TestRectangle >( "Test", 1, 0, "TestRectangle" );
@@ -169,6 +169,9 @@ sanitize {
 
 debug {
     DEFINES += ITEM_STATISTICS=1
+
+    # reporting the costs of the layout code, see QskLayoutProfiler
+    # DEFINES += LAYOUT_STATISTICS=1
 }
 
 # DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x000000
@@ -0,0 +1,224 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include <QskFlowBox.h>
+#include <QskFlowLayoutEngine.h>
+#include <QskGridBox.h>
+#include <QskPushButton.h>
+#include <QskSetup.h>
+
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QDebug>
+
+/*
+    Benchmark for resizing a QskFlowBox with a list of tags, compared
+    to rebuilding an equivalent QskGridBox, where the items have
+    to be redistributed into rows for each width.
+ */
+
+static const qreal qskSpacing = 5.0;
+
+namespace
+{
+    class FlowBox : public QskFlowBox
+    {
+      public:
+        FlowBox()
+            : QskFlowBox( Qt::Horizontal )
+        {
+            setSpacing( qskSpacing );
+        }
+
+        void layout() { updateLayout(); }
+    };
+
+    class GridBox : public QskGridBox
+    {
+      public:
+        GridBox()
+        {
+            setSpacing( qskSpacing );
+        }
+
+        void layout() { updateLayout(); }
+
+        void rebuild( const QVector< QskControl* >& items,
+            const QVector< qreal >& widths, qreal width )
+        {
+            clear();
+
+            // the same line breaks, that are done by QskFlowBox
+
+            int row = 0;
+            int column = 0;
+            qreal x = 0.0;
+
+            for ( int i = 0; i < items.count(); i++ )
+            {
+                if ( column > 0 && x + widths[i] > width )
+                {
+                    row++;
+                    column = 0;
+                    x = 0.0;
+                }
+
+                addItem( items[i], row, column++ );
+                x += widths[i] + qskSpacing;
+            }
+        }
+    };
+
+    class Result
+    {
+      public:
+        qint64 flow = 0; // nsecs per resize
+        qint64 grid = 0; // nsecs per resize
+        QskFlowLayoutEngine::Statistics statistics;
+    };
+}
+
+static QVector< QskControl* > qskCreateTags( int count )
+{
+    static const char* words[] =
+    {
+        "Qt", "Layout", "QSkinny", "Scene Graph", "C++",
+        "Flow", "Embedded", "Performance", "UI", "Benchmark"
+    };
+
+    const int wordCount = sizeof( words ) / sizeof( words[0] );
+
+    QVector< QskControl* > tags;
+    tags.reserve( count );
+
+    for ( int i = 0; i < count; i++ )
+    {
+        QString text = words[ i % wordCount ];
+        if ( i % 3 == 0 )
+            text += QString::number( i );
+
+        tags += new QskPushButton( text );
+    }
+
+    return tags;
+}
+
+static QVector< qreal > qskWidths( int resizeCount )
+{
+    // a triangle wave between 300 and 1200
+
+    QVector< qreal > widths;
+    widths.reserve( resizeCount );
+
+    qreal width = 300.0;
+    qreal step = 7.0;
+
+    for ( int i = 0; i < resizeCount; i++ )
+    {
+        widths += width;
+
+        if ( width + step > 1200.0 || width + step < 300.0 )
+            step = -step;
+
+        width += step;
+    }
+
+    return widths;
+}
+
+static Result runBenchmark( int itemCount, const QVector< qreal >& widths )
+{
+    Result result;
+
+    QElapsedTimer timer;
+
+    {
+        FlowBox box;
+
+        const auto tags = qskCreateTags( itemCount );
+        for ( auto tag : tags )
+            box.addItem( tag );
+
+        QskFlowLayoutEngine::resetStatistics();
+
+        timer.start();
+
+        for ( const auto width : widths )
+        {
+            box.setSize( QSizeF( width, box.heightForWidth( width ) ) );
+            box.layout();
+        }
+
+        result.flow = timer.nsecsElapsed() / widths.count();
+        result.statistics = QskFlowLayoutEngine::statistics();
+    }
+
+    {
+        GridBox box;
+
+        const auto tags = qskCreateTags( itemCount );
+
+        QVector< qreal > tagWidths;
+        tagWidths.reserve( tags.count() );
+
+        for ( auto tag : tags )
+        {
+            tag->setParent( &box );
+            tagWidths += tag->preferredSize().width();
+        }
+
+        timer.start();
+
+        for ( const auto width : widths )
+        {
+            box.rebuild( tags, tagWidths, width );
+
+            box.setSize( QSizeF( width, box.heightForWidth( width ) ) );
+            box.layout();
+        }
+
+        result.grid = timer.nsecsElapsed() / widths.count();
+    }
+
+    return result;
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( !qEnvironmentVariableIsSet( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+    QGuiApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Benchmark for resizing QskFlowBox compared to a QskGridBox rebuild" );
+    parser.addHelpOption();
+
+    QCommandLineOption resizesOption( "resizes",
+        "Number of resize steps.", "count", "200" );
+    parser.addOption( resizesOption );
+
+    parser.process( app );
+
+    ( void ) qskSetup->skin();
+
+    const auto widths = qskWidths( qMax( parser.value( resizesOption ).toInt(), 1 ) );
+
+    for ( const int itemCount : { 100, 1000, 5000 } )
+    {
+        const auto result = runBenchmark( itemCount, widths );
+
+        qDebug().nospace() << itemCount << " items"
+            << ", flow: " << result.flow / 1000.0 << "us"
+            << ", grid: " << result.grid / 1000.0 << "us"
+            << ", hint queries: " << result.statistics.hintQueries
+            << ", reflows: " << result.statistics.reflows
+            << ", reflowed lines: " << result.statistics.reflowedLines;
+    }
+
+    return 0;
+}
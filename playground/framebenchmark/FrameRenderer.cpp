@@ -0,0 +1,219 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "FrameRenderer.h"
+#include "FrameStatistics.h"
+
+#include <QskQuick.h>
+#include <QskWindow.h>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLFunctions>
+#include <QPointer>
+#include <QQuickRenderControl>
+#include <QResizeEvent>
+
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    #include <QQuickGraphicsDevice>
+    #include <QQuickRenderTarget>
+#endif
+
+class FrameRenderer::PrivateData
+{
+  public:
+    PrivateData( const QSize& size )
+        : size( size )
+    {
+    }
+
+    QSize size;
+
+    QOpenGLContext context;
+    QOffscreenSurface surface;
+
+    std::unique_ptr< QQuickRenderControl > renderControl;
+    std::unique_ptr< QskWindow > window;
+    std::unique_ptr< QOpenGLFramebufferObject > fbo;
+
+    QPointer< QQuickItem > scene;
+};
+
+FrameRenderer::FrameRenderer( const QSize& size )
+    : m_data( new PrivateData( size ) )
+{
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    QQuickWindow::setGraphicsApi( QSGRendererInterface::OpenGL );
+#endif
+
+    m_data->renderControl.reset( new QQuickRenderControl() );
+    m_data->window.reset( new QskWindow( m_data->renderControl.get() ) );
+
+    m_data->window->setGeometry( QRect( QPoint(), size ) );
+}
+
+FrameRenderer::~FrameRenderer()
+{
+    // the scene graph has to be released with a current context
+
+    m_data->context.makeCurrent( &m_data->surface );
+
+    delete m_data->scene;
+
+    m_data->fbo.reset();
+    m_data->renderControl.reset();
+    m_data->window.reset();
+
+    m_data->context.doneCurrent();
+}
+
+bool FrameRenderer::initialize()
+{
+    QSurfaceFormat format;
+    format.setDepthBufferSize( 16 );
+    format.setStencilBufferSize( 8 );
+
+    m_data->context.setFormat( format );
+    if ( !m_data->context.create() )
+        return false;
+
+    m_data->surface.setFormat( m_data->context.format() );
+    m_data->surface.create();
+
+    if ( !m_data->context.makeCurrent( &m_data->surface ) )
+        return false;
+
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    m_data->window->setGraphicsDevice(
+        QQuickGraphicsDevice::fromOpenGLContext( &m_data->context ) );
+
+    if ( !m_data->renderControl->initialize() )
+        return false;
+#else
+    m_data->renderControl->initialize( &m_data->context );
+#endif
+
+    createRenderTarget();
+
+    return true;
+}
+
+QString FrameRenderer::rendererName() const
+{
+    if ( !m_data->context.isValid() )
+        return QString();
+
+    m_data->context.makeCurrent( &m_data->surface );
+
+    const auto name = m_data->context.functions()->glGetString( GL_RENDERER );
+    return QString::fromLatin1( reinterpret_cast< const char* >( name ) );
+}
+
+QskWindow* FrameRenderer::window() const
+{
+    return m_data->window.get();
+}
+
+void FrameRenderer::setScene( QQuickItem* scene )
+{
+    if ( m_data->scene )
+        delete m_data->scene;
+
+    m_data->scene = scene;
+
+    if ( scene )
+    {
+        m_data->window->addItem( scene );
+        layoutScene();
+    }
+}
+
+void FrameRenderer::resize( const QSize& size )
+{
+    if ( size == m_data->size )
+        return;
+
+    const auto oldSize = m_data->size;
+    m_data->size = size;
+
+    auto window = m_data->window.get();
+    window->setGeometry( QRect( QPoint(), size ) );
+
+    /*
+        The window is never exposed, so we have to deliver the resize
+        and to do the layout of its children manually.
+     */
+    QResizeEvent event( size, oldSize );
+    QCoreApplication::sendEvent( window, &event );
+
+    layoutScene();
+
+    m_data->context.makeCurrent( &m_data->surface );
+    createRenderTarget();
+}
+
+QSize FrameRenderer::size() const
+{
+    return m_data->size;
+}
+
+void FrameRenderer::renderFrame( FrameStatistics& statistics )
+{
+    auto renderControl = m_data->renderControl.get();
+
+    m_data->context.makeCurrent( &m_data->surface );
+
+    QElapsedTimer timer;
+
+    timer.start();
+    QCoreApplication::sendPostedEvents();
+    statistics.addSample( FrameStatistics::Events, timer.nsecsElapsed() );
+
+    timer.start();
+    renderControl->polishItems();
+    statistics.addSample( FrameStatistics::Polish, timer.nsecsElapsed() );
+
+    timer.start();
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    renderControl->beginFrame();
+#endif
+    renderControl->sync();
+    statistics.addSample( FrameStatistics::Sync, timer.nsecsElapsed() );
+
+    timer.start();
+    renderControl->render();
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    renderControl->endFrame();
+#endif
+
+    // otherwise we would measure how fast commands can be queued only
+    m_data->context.functions()->glFinish();
+
+    statistics.addSample( FrameStatistics::Render, timer.nsecsElapsed() );
+}
+
+void FrameRenderer::createRenderTarget()
+{
+    auto fbo = new QOpenGLFramebufferObject(
+        m_data->size, QOpenGLFramebufferObject::CombinedDepthStencil );
+
+    m_data->fbo.reset( fbo );
+
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    m_data->window->setRenderTarget(
+        QQuickRenderTarget::fromOpenGLTexture( fbo->texture(), fbo->size() ) );
+#else
+    m_data->window->setRenderTarget( fbo );
+#endif
+}
+
+void FrameRenderer::layoutScene()
+{
+    if ( m_data->scene )
+        qskSetItemGeometry( m_data->scene, QRectF( QPointF(), m_data->size ) );
+}
@@ -0,0 +1,51 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#pragma once
+
+#include <QSize>
+#include <QString>
+#include <memory>
+
+class QskWindow;
+class QQuickItem;
+class FrameStatistics;
+
+/*
+    Rendering a QskWindow offscreen by a QQuickRenderControl into a
+    framebuffer object, while measuring the phases of each frame.
+
+    The render control needs an OpenGL context, so for running headless
+    QT_QPA_PLATFORM=offscreen is combined with a software rasterizer
+    like llvmpipe ( LIBGL_ALWAYS_SOFTWARE=1 ).
+ */
+class FrameRenderer
+{
+  public:
+    FrameRenderer( const QSize& );
+    ~FrameRenderer();
+
+    bool initialize();
+
+    // GL_RENDERER, f.e. "llvmpipe ( LLVM 12.0.0, 256 bits )"
+    QString rendererName() const;
+
+    QskWindow* window() const;
+
+    // the item is resized to the window, like with autoLayoutChildren
+    void setScene( QQuickItem* );
+
+    void resize( const QSize& );
+    QSize size() const;
+
+    void renderFrame( FrameStatistics& );
+
+  private:
+    void createRenderTarget();
+    void layoutScene();
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "FrameStatistics.h"
+
+#include <QJsonObject>
+
+#include <algorithm>
+#include <cmath>
+
+static const char* qskPhaseNames[] = { "events", "polish", "sync", "render" };
+
+static qreal qskPercentile( const QVector< qint64 >& sorted, qreal p )
+{
+    if ( sorted.isEmpty() )
+        return 0.0;
+
+    int rank = static_cast< int >( std::ceil( p / 100.0 * sorted.count() ) );
+    rank = qBound( 1, rank, sorted.count() );
+
+    return sorted[ rank - 1 ] / 1e6;
+}
+
+static QJsonObject qskSummary( QVector< qint64 > values )
+{
+    std::sort( values.begin(), values.end() );
+
+    qreal sum = 0.0;
+    for ( const auto value : qAsConst( values ) )
+        sum += value;
+
+    QJsonObject object;
+
+    object[ "p50" ] = qskPercentile( values, 50 );
+    object[ "p90" ] = qskPercentile( values, 90 );
+    object[ "p99" ] = qskPercentile( values, 99 );
+    object[ "max" ] = values.isEmpty() ? 0.0 : values.last() / 1e6;
+    object[ "mean" ] = values.isEmpty() ? 0.0 : sum / values.count() / 1e6;
+
+    return object;
+}
+
+void FrameStatistics::addSample( Phase phase, qint64 nsecs )
+{
+    m_samples[ phase ] += nsecs;
+}
+
+void FrameStatistics::clear()
+{
+    for ( auto& samples : m_samples )
+        samples.clear();
+}
+
+int FrameStatistics::sampleCount( Phase phase ) const
+{
+    return m_samples[ phase ].count();
+}
+
+qreal FrameStatistics::percentile( Phase phase, qreal p ) const
+{
+    auto values = m_samples[ phase ];
+    std::sort( values.begin(), values.end() );
+
+    return qskPercentile( values, p );
+}
+
+QVector< qint64 > FrameStatistics::samples( int phase ) const
+{
+    if ( phase < PhaseCount )
+        return m_samples[ phase ];
+
+    // the sum of all phases of a frame
+
+    QVector< qint64 > frames( m_samples[ 0 ].count(), 0 );
+
+    for ( const auto& samples : m_samples )
+    {
+        for ( int i = 0; i < frames.count() && i < samples.count(); i++ )
+            frames[ i ] += samples[ i ];
+    }
+
+    return frames;
+}
+
+QJsonObject FrameStatistics::toJson() const
+{
+    QJsonObject object;
+
+    for ( int phase = 0; phase < PhaseCount; phase++ )
+        object[ qskPhaseNames[ phase ] ] = qskSummary( samples( phase ) );
+
+    object[ "frame" ] = qskSummary( samples( PhaseCount ) );
+
+    return object;
+}
@@ -0,0 +1,43 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#pragma once
+
+#include <QVector>
+
+class QJsonObject;
+
+class FrameStatistics
+{
+  public:
+    enum Phase
+    {
+        Events, // posted events, f.e. layout requests
+        Polish,
+        Sync,
+        Render,
+
+        PhaseCount
+    };
+
+    void addSample( Phase, qint64 nsecs );
+    void clear();
+
+    int sampleCount( Phase ) const;
+
+    // nearest rank, in milliseconds
+    qreal percentile( Phase, qreal p ) const;
+
+    /*
+        { "events": { "p50": ..., "p90": ..., "p99": ..., "max": ..., "mean": ... },
+          "polish": ..., "sync": ..., "render": ..., "frame": ... }
+     */
+    QJsonObject toJson() const;
+
+  private:
+    QVector< qint64 > samples( int phase ) const;
+
+    QVector< qint64 > m_samples[ PhaseCount ];
+};
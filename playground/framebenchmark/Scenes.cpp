@@ -0,0 +1,423 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "Scenes.h"
+
+#include "label/LabelPage.h"
+#include "progressbar/ProgressBarPage.h"
+#include "slider/SliderPage.h"
+#include "button/ButtonPage.h"
+
+#include "DynamicConstraintsPage.h"
+#include "FlowLayoutPage.h"
+#include "LinearLayoutPage.h"
+#include "StackLayoutPage.h"
+
+#include <SkinnyShapeFactory.h>
+
+#include <QskFunctions.h>
+#include <QskGraphic.h>
+#include <QskLinearBox.h>
+#include <QskPaintedNode.h>
+#include <QskPushButton.h>
+#include <QskScrollArea.h>
+#include <QskSimpleListBox.h>
+#include <QskTabView.h>
+#include <QskTextLabel.h>
+#include <QskVirtualLinearBox.h>
+
+#include <QPainter>
+#include <QQuickWindow>
+#include <QRegion>
+#include <QtMath>
+
+#include <cmath>
+
+namespace
+{
+    /*
+        Condensed versions of the scenes of the gallery, layouts,
+        thumbnails and listbox examples. Anything random has been
+        replaced by something deterministic, so that runs are comparable.
+     */
+
+    class TabView : public QskTabView
+    {
+      public:
+        TabView()
+        {
+            setMargins( 10 );
+            setTabPosition( Qsk::Left );
+            setAutoFitTabs( true );
+        }
+    };
+
+    class Thumbnail : public QskPushButton
+    {
+      public:
+        Thumbnail( int index, QQuickItem* parentItem )
+            : QskPushButton( parentItem )
+        {
+            static const char* colors[] =
+            {
+                "HotPink", "FireBrick", "Gold", "Turquoise", "CadetBlue",
+                "CornflowerBlue", "Plum", "DarkSlateBlue", "MistyRose", "Silver"
+            };
+
+            const int colorCount = sizeof( colors ) / sizeof( colors[ 0 ] );
+
+            const auto shape = static_cast< SkinnyShapeFactory::Shape >(
+                index % SkinnyShapeFactory::ShapeCount );
+
+            const QSizeF size( 150, 150 );
+
+            QPen pen( Qt::black, 3 );
+            pen.setJoinStyle( Qt::MiterJoin );
+            pen.setCosmetic( true );
+
+            QskGraphic graphic;
+
+            QPainter painter( &graphic );
+            painter.setRenderHint( QPainter::Antialiasing, true );
+            painter.setPen( pen );
+            painter.setBrush( QColor( colors[ ( index / 7 ) % colorCount ] ) );
+            painter.drawPath( SkinnyShapeFactory::shapePath( shape, size ) );
+            painter.end();
+
+            setGraphic( graphic );
+            setFixedSize( size );
+            setFlat( true );
+        }
+    };
+
+    class Thumbnails : public QskScrollArea
+    {
+      public:
+        Thumbnails()
+        {
+            const int dim = 20;
+
+            auto box = new QskLinearBox( Qt::Horizontal, dim );
+            box->setMargins( 20 );
+            box->setSpacing( 20 );
+
+            for ( int i = 0; i < dim * dim; i++ )
+                ( void ) new Thumbnail( i, box );
+
+            setItemResizable( false );
+            setScrolledItem( box );
+        }
+    };
+
+    class ListBox : public QskSimpleListBox
+    {
+      public:
+        ListBox()
+        {
+            setMargins( QMarginsF( 15, 10, 10, 10 ) );
+            setAlternatingRowColors( true );
+            setPaddingHint( Cell, QMargins( 10, 20, 10, 20 ) );
+
+            const int count = 10000;
+            const QString format( "Row %1: The quick brown fox jumps over the lazy dog" );
+
+            QStringList entries;
+            entries.reserve( count );
+
+            for ( int i = 0; i < count; i++ )
+                entries += format.arg( i + 1 );
+
+            setColumnWidthHint( 0,
+                qskHorizontalAdvance( effectiveFont( Cell ), entries.last() ) );
+
+            append( entries );
+            setSelectedRow( 5 );
+        }
+    };
+
+    class VirtualBox : public QskVirtualLinearBox
+    {
+      public:
+        VirtualBox()
+            : QskVirtualLinearBox( Qt::Vertical )
+        {
+            setMargins( 10 );
+            setItemCount( 20000 );
+        }
+
+      protected:
+        QQuickItem* createItem() override
+        {
+            auto label = new QskTextLabel();
+            label->setWrapMode( QskTextOptions::WordWrap );
+            label->setSizePolicy( QskSizePolicy::Ignored, QskSizePolicy::Constrained );
+
+            return label;
+        }
+
+        void updateItem( QQuickItem* item, int index ) override
+        {
+            // rows of different heights
+            QString text = QStringLiteral( "Row %1:" ).arg( index + 1 );
+            for ( int i = 0; i <= index % 5; i++ )
+                text += QStringLiteral( " The quick brown fox jumps over the lazy dog." );
+
+            static_cast< QskTextLabel* >( item )->setText( text );
+        }
+    };
+
+    /*
+        Dials with a moving needle on top of a face, that is expensive
+        to paint. Only the bounding rectangles of the old and the new
+        needle change, so incremental nodes repaint a small part only.
+     */
+    class DialNode final : public QskPaintedNode
+    {
+      public:
+        void setAngle( qreal angle, const QSizeF& size )
+        {
+            m_dirtyRegion = needleRect( m_angle, size ) | needleRect( angle, size );
+            m_angle = angle;
+        }
+
+      protected:
+        void paint( QPainter* painter, const QSizeF& size ) override
+        {
+            painter->setRenderHint( QPainter::Antialiasing, true );
+
+            const QRectF rect( 0.0, 0.0, size.width(), size.height() );
+            const auto center = rect.center();
+            const qreal radius = 0.5 * qMin( size.width(), size.height() ) - 2.0;
+
+            painter->setPen( QPen( Qt::darkGray, 2 ) );
+            painter->setBrush( QColor( "Lavender" ) );
+            painter->drawEllipse( center, radius, radius );
+
+            for ( int i = 0; i < 360; i += 3 )
+            {
+                const qreal length = ( i % 30 == 0 ) ? 0.15 : 0.07;
+
+                painter->setPen( QPen( Qt::black, ( i % 30 == 0 ) ? 2 : 1 ) );
+                painter->drawLine( point( center, radius, i ),
+                    point( center, radius * ( 1.0 - length ), i ) );
+            }
+
+            painter->setPen( QPen( Qt::red, NeedleWidth, Qt::SolidLine, Qt::RoundCap ) );
+            painter->drawLine( center, point( center, needleLength( size ), m_angle ) );
+        }
+
+        QskHashValue hash() const override
+        {
+            return qHash( m_angle, 1 );
+        }
+
+        QRegion dirtyRegion() const override
+        {
+            return m_dirtyRegion;
+        }
+
+      private:
+        enum { NeedleWidth = 6 };
+
+        static qreal needleLength( const QSizeF& size )
+        {
+            return 0.4 * qMin( size.width(), size.height() );
+        }
+
+        static QPointF point( const QPointF& center, qreal radius, qreal angle )
+        {
+            const qreal radians = qDegreesToRadians( angle );
+
+            return QPointF( center.x() + radius * qCos( radians ),
+                center.y() - radius * qSin( radians ) );
+        }
+
+        static QRect needleRect( qreal angle, const QSizeF& size )
+        {
+            const auto center = QRectF( QPointF(), size ).center();
+            const auto tip = point( center, needleLength( size ), angle );
+
+            const qreal m = NeedleWidth;
+
+            return QRectF( center, tip ).normalized()
+                .adjusted( -m, -m, m, m ).toAlignedRect();
+        }
+
+        qreal m_angle = 0.0;
+        QRegion m_dirtyRegion;
+    };
+
+    class Dial : public QQuickItem
+    {
+      public:
+        Dial( bool incremental, QQuickItem* parentItem )
+            : QQuickItem( parentItem )
+            , m_incremental( incremental )
+        {
+            setFlag( QQuickItem::ItemHasContents, true );
+            setImplicitSize( 250, 250 );
+        }
+
+        void setAngle( qreal angle )
+        {
+            m_angle = angle;
+            update();
+        }
+
+      protected:
+        QSGNode* updatePaintNode( QSGNode* oldNode, UpdatePaintNodeData* ) override
+        {
+            auto node = static_cast< DialNode* >( oldNode );
+            if ( node == nullptr )
+            {
+                node = new DialNode();
+                node->setIncremental( m_incremental );
+            }
+
+            const QRect rect( 0, 0, width(), height() );
+
+            node->setAngle( m_angle, rect.size() );
+            node->update( window(), QskTextureRenderer::Raster, rect );
+
+            return node;
+        }
+
+      private:
+        const bool m_incremental;
+        qreal m_angle = 0.0;
+    };
+
+    class Dials : public QskLinearBox
+    {
+      public:
+        Dials( bool incremental )
+            : QskLinearBox( Qt::Horizontal, 4 )
+        {
+            setMargins( 10 );
+            setSpacing( 10 );
+
+            for ( int i = 0; i < 8; i++ )
+                ( void ) new Dial( incremental, this );
+        }
+
+        void setFrame( int frame )
+        {
+            for ( int i = 0; i < elementCount(); i++ )
+            {
+                if ( auto dial = dynamic_cast< Dial* >( itemAtIndex( i ) ) )
+                    dial->setAngle( 90.0 - 3.0 * frame - 45.0 * i );
+            }
+        }
+    };
+}
+
+static QQuickItem* qskCreateGallery()
+{
+    auto tabView = new TabView();
+
+    tabView->addTab( "Labels", new LabelPage() );
+    tabView->addTab( "Buttons", new ButtonPage() );
+    tabView->addTab( "Sliders", new SliderPage() );
+    tabView->addTab( "Progress\nBars", new ProgressBarPage() );
+
+    return tabView;
+}
+
+static QQuickItem* qskCreateLayouts()
+{
+    // the grid layout page is left out as it depends on QML
+
+    auto tabView = new TabView();
+
+    tabView->addTab( "Flow Layout", new FlowLayoutPage() );
+    tabView->addTab( "Linear Layout", new LinearLayoutPage() );
+    tabView->addTab( "Dynamic\nConstraints", new DynamicConstraintsPage() );
+    tabView->addTab( "Stack Layout", new StackLayoutPage() );
+
+    return tabView;
+}
+
+QStringList Scenes::names()
+{
+    return { "gallery", "thumbnails", "layouts",
+        "listbox", "constraints", "virtualbox", "dials", "dials-full" };
+}
+
+QQuickItem* Scenes::create( const QString& name )
+{
+    if ( name == QLatin1String( "gallery" ) )
+        return qskCreateGallery();
+
+    if ( name == QLatin1String( "thumbnails" ) )
+        return new Thumbnails();
+
+    if ( name == QLatin1String( "layouts" ) )
+        return qskCreateLayouts();
+
+    if ( name == QLatin1String( "listbox" ) )
+        return new ListBox();
+
+    if ( name == QLatin1String( "constraints" ) )
+    {
+        // lots of heightForWidth/widthForHeight requests
+        return new DynamicConstraintsPage();
+    }
+
+    if ( name == QLatin1String( "virtualbox" ) )
+        return new VirtualBox();
+
+    if ( name == QLatin1String( "dials" ) )
+    {
+        // QskPaintedNode repainting the dirty regions only
+        return new Dials( true );
+    }
+
+    if ( name == QLatin1String( "dials-full" ) )
+    {
+        // the same, but always repainting everything
+        return new Dials( false );
+    }
+
+    return nullptr;
+}
+
+void Scenes::scroll( QQuickItem* scene, int frame, qreal step )
+{
+    if ( auto dials = dynamic_cast< Dials* >( scene ) )
+    {
+        dials->setFrame( frame );
+        return;
+    }
+
+    if ( auto scrollBox = qobject_cast< QskScrollBox* >( scene ) )
+    {
+        const auto maxY = scrollBox->scrollableSize().height()
+            - scrollBox->viewContentsRect().height();
+
+        if ( maxY > 0.0 )
+        {
+            // moving forth and back between the borders
+
+            auto y = std::fmod( frame * step, 2.0 * maxY );
+            if ( y > maxY )
+                y = 2.0 * maxY - y;
+
+            scrollBox->setScrollPos( QPointF( scrollBox->scrollPos().x(), y ) );
+        }
+
+        return;
+    }
+
+    if ( auto tabView = qobject_cast< QskTabView* >( scene ) )
+    {
+        const int framesPerPage = 30;
+
+        if ( tabView->count() > 0 && ( frame % framesPerPage == 0 ) )
+        {
+            const int index = ( frame / framesPerPage ) % tabView->count();
+            tabView->setCurrentIndex( index );
+        }
+    }
+}
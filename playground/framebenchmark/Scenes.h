@@ -0,0 +1,26 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#pragma once
+
+#include <QStringList>
+
+class QQuickItem;
+
+namespace Scenes
+{
+    QStringList names();
+
+    // nullptr for unknown names
+    QQuickItem* create( const QString& name );
+
+    /*
+        Scripted navigation for a frame: scroll views are scrolled by
+        step pixels per frame bouncing at their borders, while scenes
+        without scroll view cycle through the pages of their tab view.
+        The needles of the dials are rotated by 3 degrees per frame.
+     */
+    void scroll( QQuickItem* scene, int frame, qreal step );
+}
@@ -0,0 +1,55 @@
+CONFIG += qskexample
+
+greaterThan( QT_MAJOR_VERSION, 5 ) {
+
+    # QOpenGLFramebufferObject
+    QT += opengl
+}
+
+# reusing the pages of the gallery and layouts examples
+
+GALLERY = $$PWD/../../examples/gallery
+LAYOUTS = $$PWD/../../examples/layouts
+
+INCLUDEPATH += $${GALLERY} $${LAYOUTS}
+
+HEADERS += \
+    $${GALLERY}/Page.h \
+    $${GALLERY}/label/LabelPage.h \
+    $${GALLERY}/slider/SliderPage.h \
+    $${GALLERY}/progressbar/ProgressBarPage.h \
+    $${GALLERY}/button/ButtonPage.h
+
+SOURCES += \
+    $${GALLERY}/Page.cpp \
+    $${GALLERY}/label/LabelPage.cpp \
+    $${GALLERY}/slider/SliderPage.cpp \
+    $${GALLERY}/progressbar/ProgressBarPage.cpp \
+    $${GALLERY}/button/ButtonPage.cpp
+
+HEADERS += \
+    $${LAYOUTS}/TestRectangle.h \
+    $${LAYOUTS}/ButtonBox.h \
+    $${LAYOUTS}/FlowLayoutPage.h \
+    $${LAYOUTS}/LinearLayoutPage.h \
+    $${LAYOUTS}/DynamicConstraintsPage.h \
+    $${LAYOUTS}/StackLayoutPage.h
+
+SOURCES += \
+    $${LAYOUTS}/TestRectangle.cpp \
+    $${LAYOUTS}/ButtonBox.cpp \
+    $${LAYOUTS}/FlowLayoutPage.cpp \
+    $${LAYOUTS}/LinearLayoutPage.cpp \
+    $${LAYOUTS}/DynamicConstraintsPage.cpp \
+    $${LAYOUTS}/StackLayoutPage.cpp
+
+HEADERS += \
+    Scenes.h \
+    FrameRenderer.h \
+    FrameStatistics.h
+
+SOURCES += \
+    Scenes.cpp \
+    FrameRenderer.cpp \
+    FrameStatistics.cpp \
+    main.cpp
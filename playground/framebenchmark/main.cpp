@@ -0,0 +1,226 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "FrameRenderer.h"
+#include "FrameStatistics.h"
+#include "Scenes.h"
+
+#include <SkinnyNamespace.h>
+#include <SkinnyShapeProvider.h>
+
+#include <QskGraphicProvider.h>
+#include <QskLayoutEngine2D.h>
+#include <QskSetup.h>
+
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QFile>
+#include <QGuiApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <cstdio>
+
+/*
+    Rendering the scenes of some of the examples offscreen for a fixed
+    number of frames, while scrolling, switching skins and resizing
+    the window. The percentiles of the times for the phases of the
+    frames are written as JSON, so that they can be compared between runs.
+
+    To run it without a display:
+
+        QT_QPA_PLATFORM=offscreen LIBGL_ALWAYS_SOFTWARE=1 framebenchmark
+ */
+
+namespace
+{
+    class Script
+    {
+      public:
+        int frames = 300;
+        int warmupFrames = 10;
+
+        qreal scrollStep = 10.0;
+        int skinInterval = 100;
+        int resizeInterval = 75;
+    };
+}
+
+static QSize qskParseSize( const QString& text )
+{
+    const auto values = text.split( QLatin1Char( 'x' ) );
+    if ( values.count() == 2 )
+        return QSize( values[ 0 ].toInt(), values[ 1 ].toInt() );
+
+    return QSize();
+}
+
+static QJsonObject qskRunScene( FrameRenderer& renderer,
+    const QString& name, const Script& script )
+{
+    auto scene = Scenes::create( name );
+    renderer.setScene( scene );
+
+    const auto size = renderer.size();
+
+    FrameStatistics statistics;
+
+    for ( int i = 0; i < script.warmupFrames; i++ )
+        renderer.renderFrame( statistics );
+
+    statistics.clear();
+    QskLayoutEngine2D::resetStatistics();
+
+    int skinSwitches = 0;
+    int resizes = 0;
+
+    for ( int frame = 1; frame <= script.frames; frame++ )
+    {
+        Scenes::scroll( scene, frame, script.scrollStep );
+
+        if ( script.skinInterval > 0 && ( frame % script.skinInterval == 0 ) )
+        {
+            Skinny::changeSkin( 0 );
+            skinSwitches++;
+        }
+
+        if ( script.resizeInterval > 0 && ( frame % script.resizeInterval == 0 ) )
+        {
+            // toggling between the initial size and 3/4 of it
+            const auto sz = ( renderer.size() == size ) ? size * 3 / 4 : size;
+            renderer.resize( sz );
+
+            resizes++;
+        }
+
+        renderer.renderFrame( statistics );
+    }
+
+    renderer.resize( size );
+    renderer.setScene( nullptr );
+
+    const auto layoutStatistics = QskLayoutEngine2D::statistics();
+
+    auto result = statistics.toJson();
+    result[ "skinSwitches" ] = skinSwitches;
+    result[ "resizes" ] = resizes;
+
+    // JSON numbers are doubles
+    result[ "layoutMetricsCalls" ] = double( layoutStatistics.layoutMetricsCalls );
+    result[ "metricsCacheHits" ] = double( layoutStatistics.metricsCacheHits );
+    result[ "chainCacheHits" ] = double( layoutStatistics.chainCacheHits );
+    result[ "chainCacheMisses" ] = double( layoutStatistics.chainCacheMisses );
+
+    return result;
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( !qEnvironmentVariableIsSet( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+    Qsk::addGraphicProvider( "shapes", new SkinnyShapeProvider() );
+
+    QGuiApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Offscreen frame time benchmark" );
+    parser.addHelpOption();
+
+    const QCommandLineOption sceneOption( "scene",
+        "Scene: " + Scenes::names().join( ", " ) + " ( default: all )", "name" );
+
+    const QCommandLineOption framesOption( "frames",
+        "Number of measured frames per scene ( default: 300 )", "count", "300" );
+
+    const QCommandLineOption sizeOption( "size",
+        "Initial window size ( default: 800x600 )", "WxH", "800x600" );
+
+    const QCommandLineOption stepOption( "step",
+        "Pixels scrolled per frame ( default: 10 )", "pixels", "10" );
+
+    const QCommandLineOption skinOption( "skin-interval",
+        "Frames between skin switches, 0: disabled ( default: 100 )", "frames", "100" );
+
+    const QCommandLineOption resizeOption( "resize-interval",
+        "Frames between resizes, 0: disabled ( default: 75 )", "frames", "75" );
+
+    const QCommandLineOption outputOption( "output",
+        "JSON output file ( default: stdout )", "file" );
+
+    parser.addOptions( { sceneOption, framesOption, sizeOption,
+        stepOption, skinOption, resizeOption, outputOption } );
+
+    parser.process( app );
+
+    Script script;
+    script.frames = qMax( parser.value( framesOption ).toInt(), 1 );
+    script.scrollStep = parser.value( stepOption ).toDouble();
+    script.skinInterval = parser.value( skinOption ).toInt();
+    script.resizeInterval = parser.value( resizeOption ).toInt();
+
+    const auto size = qskParseSize( parser.value( sizeOption ) );
+    if ( size.isEmpty() )
+    {
+        qWarning() << "Invalid size:" << parser.value( sizeOption );
+        return 1;
+    }
+
+    auto names = parser.values( sceneOption );
+    if ( names.isEmpty() )
+        names = Scenes::names();
+
+    for ( const auto& name : qAsConst( names ) )
+    {
+        if ( !Scenes::names().contains( name ) )
+        {
+            qWarning() << "Unknown scene:" << name;
+            return 1;
+        }
+    }
+
+    // usually done, when the window gets exposed
+    ( void ) qskSetup->skin();
+
+    FrameRenderer renderer( size );
+    if ( !renderer.initialize() )
+    {
+        qWarning() << "Can't create an OpenGL context.";
+        return 1;
+    }
+
+    QJsonObject scenes;
+    for ( const auto& name : qAsConst( names ) )
+        scenes[ name ] = qskRunScene( renderer, name, script );
+
+    QJsonObject results;
+    results[ "qtVersion" ] = QString::fromLatin1( qVersion() );
+    results[ "platform" ] = QGuiApplication::platformName();
+    results[ "renderer" ] = renderer.rendererName();
+    results[ "frames" ] = script.frames;
+    results[ "size" ] = parser.value( sizeOption );
+    results[ "unit" ] = QStringLiteral( "ms" );
+    results[ "scenes" ] = scenes;
+
+    const auto json = QJsonDocument( results ).toJson( QJsonDocument::Indented );
+
+    if ( parser.isSet( outputOption ) )
+    {
+        QFile file( parser.value( outputOption ) );
+        if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+        {
+            qWarning() << "Can't write to" << file.fileName();
+            return 1;
+        }
+
+        file.write( json );
+    }
+    else
+    {
+        std::fputs( json.constData(), stdout );
+    }
+
+    return 0;
+}
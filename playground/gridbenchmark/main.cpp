@@ -0,0 +1,126 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include <QskControl.h>
+#include <QskGridBox.h>
+
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QDebug>
+
+#include <cmath>
+
+/*
+    Benchmark for the cell lookups of QskGridBox, like they happen
+    when navigating with the keyboard or when items are replaced
+    dynamically in huge forms.
+ */
+
+namespace
+{
+    class Result
+    {
+      public:
+        qint64 populate = 0; // nsecs for all insertions
+        qint64 lookup = 0;   // nsecs per lookup
+        qint64 replace = 0;  // nsecs per remove + insert
+    };
+}
+
+static Result runBenchmark( int cellCount, int repeats )
+{
+    const int columns = qMax( 1, int( std::sqrt( cellCount ) ) );
+    const int rows = ( cellCount + columns - 1 ) / columns;
+
+    Result result;
+
+    QskGridBox box;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for ( int i = 0; i < cellCount; i++ )
+        box.addItem( new QskControl(), i / columns, i % columns );
+
+    result.populate = timer.nsecsElapsed();
+
+    // visiting all cells like when moving the focus with the arrow keys
+
+    int found = 0;
+
+    timer.start();
+
+    for ( int n = 0; n < repeats; n++ )
+    {
+        for ( int row = 0; row < rows; row++ )
+        {
+            for ( int col = 0; col < columns; col++ )
+            {
+                if ( box.itemAt( row, col ) )
+                    found++;
+            }
+        }
+    }
+
+    result.lookup = timer.nsecsElapsed() / qMax( 1, repeats * rows * columns );
+
+    if ( found != repeats * cellCount )
+        qWarning() << "Unexpected number of items:" << found;
+
+    // replacing items in the middle of the grid
+
+    const int replaceCount = 100;
+
+    timer.start();
+
+    for ( int n = 0; n < replaceCount; n++ )
+    {
+        const int row = ( n * 7 ) % rows;
+        const int col = ( n * 13 ) % columns;
+
+        const int index = box.indexAt( row, col );
+        if ( index < 0 )
+            continue;
+
+        auto item = box.itemAtIndex( index );
+        box.removeAt( index );
+
+        box.addItem( item, row, col );
+    }
+
+    result.replace = timer.nsecsElapsed() / replaceCount;
+
+    return result;
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Benchmark for cell lookups of QskGridBox" );
+    parser.addHelpOption();
+
+    QCommandLineOption repeatOption( "repeat",
+        "Number of times all cells are visited.", "count", "10" );
+    parser.addOption( repeatOption );
+
+    parser.process( app );
+
+    const int repeats = qMax( parser.value( repeatOption ).toInt(), 1 );
+
+    for ( const int cellCount : { 100, 1000, 10000 } )
+    {
+        const auto result = runBenchmark( cellCount, repeats );
+
+        qDebug().nospace() << cellCount << " cells"
+            << ", populate: " << result.populate / 1000000.0 << "ms"
+            << ", lookup: " << result.lookup << "ns"
+            << ", replace: " << result.replace / 1000.0 << "us";
+    }
+
+    return 0;
+}
@@ -0,0 +1,209 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "Trees.h"
+
+#include <QskGridBox.h>
+#include <QskLinearBox.h>
+#include <QskStackBox.h>
+#include <QskTextLabel.h>
+
+/*
+    Synthetic trees covering the different code paths of the layout
+    engines. Everything is deterministic, so that runs are comparable.
+ */
+
+namespace
+{
+    class Builder
+    {
+      public:
+        QskControl* createLeaf()
+        {
+            const int i = m_tree.itemCount++;
+
+            auto leaf = new QskControl();
+            leaf->setPreferredSize( 20 + ( i % 7 ) * 5, 15 + ( i % 5 ) * 4 );
+
+            if ( i % 11 == 0 )
+                leaf->setSizePolicy( QskSizePolicy::Expanding, QskSizePolicy::Preferred );
+
+            m_tree.leaf = leaf;
+
+            return leaf;
+        }
+
+        QskControl* createText()
+        {
+            static const char* words[] =
+            {
+                "Lorem", "ipsum", "dolor", "sit", "amet,", "consetetur",
+                "sadipscing", "elitr,", "sed", "diam", "nonumy", "eirmod"
+            };
+
+            const int wordCount = sizeof( words ) / sizeof( words[0] );
+
+            const int i = m_tree.itemCount++;
+
+            QString text;
+            for ( int j = 0; j < 8 + ( i % 5 ) * 6; j++ )
+            {
+                if ( j > 0 )
+                    text += QLatin1Char( ' ' );
+
+                text += QLatin1String( words[ ( i + j ) % wordCount ] );
+            }
+
+            auto label = new QskTextLabel( text );
+            label->setWrapMode( QskTextOptions::WordWrap );
+            label->setSizePolicy( QskSizePolicy::Ignored, QskSizePolicy::Constrained );
+
+            m_tree.leaf = label;
+
+            return label;
+        }
+
+        template< typename T >
+        T* createBox( T* box )
+        {
+            m_tree.itemCount++;
+
+            if ( m_tree.root == nullptr )
+                m_tree.root = box;
+
+            return box;
+        }
+
+        QskLinearBox* createLinearBox( Qt::Orientation orientation, uint dimension = 0 )
+        {
+            auto box = ( dimension > 0 )
+                ? new QskLinearBox( orientation, dimension )
+                : new QskLinearBox( orientation );
+
+            return createBox( box );
+        }
+
+        QskGridBox* createGrid( int rowCount, int columnCount, bool spanning )
+        {
+            auto grid = createBox( new QskGridBox() );
+
+            for ( int row = 0; row < rowCount; row++ )
+            {
+                for ( int col = 0; col < columnCount; col++ )
+                {
+                    int rowSpan = 1;
+                    int columnSpan = 1;
+
+                    if ( spanning )
+                    {
+                        if ( ( row + col ) % 5 == 0 )
+                            rowSpan = 2;
+
+                        if ( ( row * col ) % 3 == 0 )
+                            columnSpan = 2;
+                    }
+
+                    grid->addItem( createLeaf(), row, col, rowSpan, columnSpan );
+                }
+            }
+
+            return grid;
+        }
+
+        void fillDeep( QskLinearBox* box, int depth )
+        {
+            if ( depth == 0 )
+            {
+                box->addItem( createLeaf() );
+                box->addItem( createLeaf() );
+
+                return;
+            }
+
+            const auto orientation = ( box->orientation() == Qt::Horizontal )
+                ? Qt::Vertical : Qt::Horizontal;
+
+            for ( int i = 0; i < 2; i++ )
+            {
+                auto child = createLinearBox( orientation );
+                box->addItem( child );
+
+                fillDeep( child, depth - 1 );
+            }
+        }
+
+        Trees::Tree tree() const
+        {
+            return m_tree;
+        }
+
+      private:
+        Trees::Tree m_tree;
+    };
+}
+
+QStringList Trees::names()
+{
+    return { "linear-wide", "linear-deep", "linear-text",
+        "grid-wide", "grid-spanning", "grid-text", "stack" };
+}
+
+Trees::Tree Trees::create( const QString& name )
+{
+    Builder builder;
+
+    if ( name == QLatin1String( "linear-wide" ) )
+    {
+        // 2000 items wrapped in rows of 40
+        auto box = builder.createLinearBox( Qt::Horizontal, 40 );
+
+        for ( int i = 0; i < 2000; i++ )
+            box->addItem( builder.createLeaf() );
+    }
+    else if ( name == QLatin1String( "linear-deep" ) )
+    {
+        // binary tree of nested boxes with alternating orientations
+        auto box = builder.createLinearBox( Qt::Horizontal );
+        builder.fillDeep( box, 9 );
+    }
+    else if ( name == QLatin1String( "linear-text" ) )
+    {
+        // heightForWidth items
+        auto box = builder.createLinearBox( Qt::Vertical );
+
+        for ( int i = 0; i < 300; i++ )
+            box->addItem( builder.createText() );
+    }
+    else if ( name == QLatin1String( "grid-wide" ) )
+    {
+        builder.createGrid( 50, 40, false );
+    }
+    else if ( name == QLatin1String( "grid-spanning" ) )
+    {
+        builder.createGrid( 40, 40, true );
+    }
+    else if ( name == QLatin1String( "grid-text" ) )
+    {
+        auto grid = builder.createBox( new QskGridBox() );
+
+        for ( int row = 0; row < 40; row++ )
+        {
+            for ( int col = 0; col < 5; col++ )
+                grid->addItem( builder.createText(), row, col );
+        }
+    }
+    else if ( name == QLatin1String( "stack" ) )
+    {
+        // all pages contribute to the hints of the stack box
+        auto stack = builder.createBox( new QskStackBox() );
+
+        for ( int i = 0; i < 20; i++ )
+            stack->addItem( builder.createGrid( 10, 10, i % 2 ) );
+
+        stack->setCurrentIndex( 19 );
+    }
+
+    return builder.tree();
+}
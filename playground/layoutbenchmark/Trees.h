@@ -0,0 +1,30 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#pragma once
+
+#include <QStringList>
+
+class QQuickItem;
+class QskControl;
+
+namespace Trees
+{
+    class Tree
+    {
+      public:
+        QQuickItem* root = nullptr;
+
+        // a leaf, that is modified for measuring invalidations
+        QskControl* leaf = nullptr;
+
+        int itemCount = 0;
+    };
+
+    QStringList names();
+
+    // an empty tree for unknown names
+    Tree create( const QString& name );
+}
@@ -0,0 +1,8 @@
+CONFIG += qskexample
+
+HEADERS += \
+    Trees.h
+
+SOURCES += \
+    Trees.cpp \
+    main.cpp
@@ -0,0 +1,199 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "Trees.h"
+
+#include <QskControl.h>
+#include <QskLayoutEngine2D.h>
+#include <QskQuick.h>
+#include <QskSetup.h>
+#include <QskWindow.h>
+
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGuiApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <cstdio>
+
+/*
+    Measuring the layout code of QskLinearBox, QskGridBox and QskStackBox
+    for synthetic trees without rendering anything:
+
+        - build:        creating the tree
+        - firstLayout:  the initial polish of the tree
+        - resize:       a sweep of width changes, each followed by a polish
+        - invalidate:   changing the preferred size of a single leaf,
+                        followed by a polish
+
+    The results are written as JSON, so that they can be compared between
+    runs, f.e. before and after modifications of QskLayoutChain.
+
+    The window is never shown, so it runs without a display:
+
+        QT_QPA_PLATFORM=offscreen layoutbenchmark
+ */
+
+static inline double qskMicroseconds( qint64 ns )
+{
+    return ns / 1000.0;
+}
+
+static QJsonObject qskRunTree( QskWindow& window,
+    const QString& name, const QSize& size, int steps )
+{
+    QskLayoutEngine2D::resetStatistics();
+
+    QElapsedTimer timer;
+
+    timer.start();
+
+    const auto tree = Trees::create( name );
+    tree.root->setParentItem( window.contentItem() );
+
+    const auto buildTime = timer.nsecsElapsed();
+
+    timer.start();
+
+    qskSetItemGeometry( tree.root, QRectF( QPointF(), size ) );
+    window.polishItems();
+
+    const auto firstLayoutTime = timer.nsecsElapsed();
+
+    timer.start();
+
+    for ( int i = 1; i <= steps; i++ )
+    {
+        // a triangle wave between the initial width and half of it
+        const int period = 20;
+        const int pos = i % period;
+        const int k = ( pos <= period / 2 ) ? pos : period - pos;
+
+        const qreal width = size.width() * ( 1.0 - 0.05 * k );
+
+        qskSetItemGeometry( tree.root, QRectF( 0.0, 0.0, width, size.height() ) );
+        window.polishItems();
+    }
+
+    const auto resizeTime = timer.nsecsElapsed();
+
+    qskSetItemGeometry( tree.root, QRectF( QPointF(), size ) );
+    window.polishItems();
+
+    const auto preferredSize = tree.leaf->preferredSize();
+
+    timer.start();
+
+    for ( int i = 1; i <= steps; i++ )
+    {
+        tree.leaf->setPreferredSize(
+            ( i % 2 ) ? preferredSize + QSizeF( 10.0, 10.0 ) : preferredSize );
+
+        window.polishItems();
+    }
+
+    const auto invalidateTime = timer.nsecsElapsed();
+
+    const auto statistics = QskLayoutEngine2D::statistics();
+
+    delete tree.root;
+
+    QJsonObject result;
+    result[ "items" ] = tree.itemCount;
+    result[ "build" ] = qskMicroseconds( buildTime );
+    result[ "firstLayout" ] = qskMicroseconds( firstLayoutTime );
+    result[ "resize" ] = qskMicroseconds( resizeTime ) / steps;
+    result[ "invalidate" ] = qskMicroseconds( invalidateTime ) / steps;
+
+    // JSON numbers are doubles
+    result[ "layoutMetricsCalls" ] = double( statistics.layoutMetricsCalls );
+    result[ "metricsCacheHits" ] = double( statistics.metricsCacheHits );
+    result[ "chainCacheHits" ] = double( statistics.chainCacheHits );
+    result[ "chainCacheMisses" ] = double( statistics.chainCacheMisses );
+
+    return result;
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( !qEnvironmentVariableIsSet( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+    QGuiApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Headless layout benchmark" );
+    parser.addHelpOption();
+
+    const QCommandLineOption treeOption( "tree",
+        "Tree: " + Trees::names().join( ", " ) + " ( default: all )", "name" );
+
+    const QCommandLineOption stepsOption( "steps",
+        "Number of resizes/invalidations per tree ( default: 50 )", "count", "50" );
+
+    const QCommandLineOption outputOption( "output",
+        "JSON output file ( default: stdout )", "file" );
+
+    parser.addOptions( { treeOption, stepsOption, outputOption } );
+
+    parser.process( app );
+
+    const int steps = qMax( parser.value( stepsOption ).toInt(), 1 );
+
+    auto names = parser.values( treeOption );
+    if ( names.isEmpty() )
+        names = Trees::names();
+
+    for ( const auto& name : qAsConst( names ) )
+    {
+        if ( !Trees::names().contains( name ) )
+        {
+            qWarning() << "Unknown tree:" << name;
+            return 1;
+        }
+    }
+
+    // usually done, when the window gets exposed
+    ( void ) qskSetup->skin();
+
+    const QSize size( 1000, 800 );
+
+    QskWindow window;
+    window.resize( size );
+
+    QJsonObject trees;
+    for ( const auto& name : qAsConst( names ) )
+        trees[ name ] = qskRunTree( window, name, size, steps );
+
+    QJsonObject results;
+    results[ "qtVersion" ] = QString::fromLatin1( qVersion() );
+    results[ "platform" ] = QGuiApplication::platformName();
+    results[ "steps" ] = steps;
+    results[ "unit" ] = QStringLiteral( "us" );
+    results[ "trees" ] = trees;
+
+    const auto json = QJsonDocument( results ).toJson( QJsonDocument::Indented );
+
+    if ( parser.isSet( outputOption ) )
+    {
+        QFile file( parser.value( outputOption ) );
+        if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+        {
+            qWarning() << "Can't write to" << file.fileName();
+            return 1;
+        }
+
+        file.write( json );
+    }
+    else
+    {
+        std::fputs( json.constData(), stdout );
+    }
+
+    return 0;
+}
@@ -3,9 +3,14 @@ TEMPLATE = subdirs
 SUBDIRS += \
     anchors \
     dialogbuttons \
+    flowbenchmark \
+    framebenchmark \
+    gridbenchmark \
     invoker \
     inputpanel \
-    images
+    layoutbenchmark \
+    images \
+    scales
 
 lessThan(QT_MAJOR_VERSION, 6) {
 
@@ -0,0 +1,141 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "Axis.h"
+
+#include <QskScaleEngine.h>
+#include <QskScaleRenderer.h>
+#include <QskScaleTickmarks.h>
+#include <QskSkinlet.h>
+#include <QskTextColors.h>
+
+#include <QElapsedTimer>
+
+namespace
+{
+    class Skinlet : public QskSkinlet
+    {
+      public:
+        enum NodeRole { ScaleRole };
+
+        Skinlet()
+        {
+            setNodeRoles( { ScaleRole } );
+        }
+
+        QSGNode* updateSubNode( const QskSkinnable* skinnable,
+            quint8 nodeRole, QSGNode* node ) const override
+        {
+            if ( nodeRole != ScaleRole )
+                return nullptr;
+
+            const auto axis = static_cast< const Axis* >( skinnable );
+
+            const auto r = axis->contentsRect();
+            if ( r.isEmpty() )
+                return nullptr;
+
+            QRectF ticksRect, labelsRect;
+            if ( axis->orientation() == Qt::Horizontal )
+            {
+                ticksRect = QRectF( r.left(), r.top(), r.width(), 0.5 * r.height() );
+                labelsRect = QRectF( r.left(), ticksRect.bottom(), r.width(), 0.5 * r.height() );
+            }
+            else
+            {
+                labelsRect = QRectF( r.left(), r.top(), 0.5 * r.width(), r.height() );
+                ticksRect = QRectF( labelsRect.right(), r.top(), 0.5 * r.width(), r.height() );
+            }
+
+            const auto boundaries = axis->boundaries();
+
+            /*
+                Using a fixed step size, so that the values of the
+                ticks do not change, when scrolling
+             */
+            const auto tickmarks = QskScaleEngine().divideScale(
+                boundaries.lowerBound(), boundaries.upperBound(), 10, 5, 10.0 );
+
+            QskScaleRenderer renderer;
+            renderer.setOrientation( axis->orientation() );
+            renderer.setBoundaries( boundaries );
+            renderer.setTickmarks( tickmarks );
+            renderer.setTickColor( Qt::darkGray );
+            renderer.setTextColors( QskTextColors( Qt::black ) );
+
+            QElapsedTimer timer;
+            timer.start();
+
+            node = renderer.updateScaleNode( skinnable, ticksRect, labelsRect, node );
+
+            axis->addUpdateTime( timer.nsecsElapsed() );
+
+            return node;
+        }
+    };
+}
+
+Axis::Axis( Qt::Orientation orientation, QQuickItem* parent )
+    : QskControl( parent )
+    , m_orientation( orientation )
+    , m_boundaries( 0.0, 100.0 )
+{
+    setFlag( QQuickItem::ItemHasContents, true );
+    setSkinlet( new Skinlet() );
+
+    if ( orientation == Qt::Horizontal )
+        initSizePolicy( QskSizePolicy::Preferred, QskSizePolicy::Fixed );
+    else
+        initSizePolicy( QskSizePolicy::Fixed, QskSizePolicy::Preferred );
+
+    setPreferredSize( 60, 60 );
+}
+
+Axis::~Axis()
+{
+}
+
+Qt::Orientation Axis::orientation() const
+{
+    return m_orientation;
+}
+
+void Axis::setBoundaries( const QskIntervalF& boundaries )
+{
+    if ( boundaries != m_boundaries )
+    {
+        m_boundaries = boundaries;
+        update();
+    }
+}
+
+QskIntervalF Axis::boundaries() const
+{
+    return m_boundaries;
+}
+
+void Axis::addUpdateTime( qint64 nsecs ) const
+{
+    m_updateCount++;
+    m_totalUpdateTime += nsecs;
+    m_maxUpdateTime = qMax( m_maxUpdateTime, nsecs );
+}
+
+int Axis::updateCount() const
+{
+    return m_updateCount;
+}
+
+qint64 Axis::totalUpdateTime() const
+{
+    return m_totalUpdateTime;
+}
+
+qint64 Axis::maxUpdateTime() const
+{
+    return m_maxUpdateTime;
+}
+
+#include "moc_Axis.cpp"
@@ -0,0 +1,38 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#pragma once
+
+#include <QskControl.h>
+#include <QskIntervalF.h>
+
+class Axis : public QskControl
+{
+    Q_OBJECT
+
+  public:
+    Axis( Qt::Orientation, QQuickItem* parent = nullptr );
+    ~Axis() override;
+
+    Qt::Orientation orientation() const;
+
+    void setBoundaries( const QskIntervalF& );
+    QskIntervalF boundaries() const;
+
+    // the time, that has been spent for updating the scene graph nodes
+    void addUpdateTime( qint64 nsecs ) const;
+
+    int updateCount() const;
+    qint64 totalUpdateTime() const;
+    qint64 maxUpdateTime() const;
+
+  private:
+    const Qt::Orientation m_orientation;
+    QskIntervalF m_boundaries;
+
+    mutable int m_updateCount = 0;
+    mutable qint64 m_totalUpdateTime = 0;
+    mutable qint64 m_maxUpdateTime = 0;
+};
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#include "Axis.h"
+
+#include <QskLinearBox.h>
+#include <QskWindow.h>
+
+#include <QCommandLineParser>
+#include <QGuiApplication>
+#include <QDebug>
+
+/*
+    Benchmark for scales, that are scrolled in every frame - like
+    the time axis of a plot showing live data.
+ */
+
+static void printResult( const char* title, const Axis* axis )
+{
+    const int count = axis->updateCount();
+    if ( count == 0 )
+        return;
+
+    qDebug().nospace() << title << ": " << count << " updates"
+        << ", average: " << axis->totalUpdateTime() / count / 1000 << "us"
+        << ", max: " << axis->maxUpdateTime() / 1000 << "us";
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Benchmark for scrolling scales" );
+    parser.addHelpOption();
+
+    QCommandLineOption framesOption( "frames",
+        "Number of frames to be rendered, before printing the result.",
+        "count", "1000" );
+    parser.addOption( framesOption );
+
+    QCommandLineOption stepOption( "step",
+        "Scrolled distance in scale coordinates for each frame.",
+        "value", "0.37" );
+    parser.addOption( stepOption );
+
+    parser.process( app );
+
+    const int frameCount = qMax( parser.value( framesOption ).toInt(), 1 );
+    const qreal step = parser.value( stepOption ).toDouble();
+
+    auto hAxis = new Axis( Qt::Horizontal );
+    auto vAxis = new Axis( Qt::Vertical );
+
+    auto box = new QskLinearBox( Qt::Horizontal );
+    box->setMargins( 10 );
+    box->addItem( vAxis );
+    box->addItem( hAxis, Qt::AlignBottom );
+
+    QskWindow window;
+    window.setColor( Qt::white );
+    window.resize( 800, 600 );
+    window.addItem( box );
+
+    int frame = 0;
+
+    QObject::connect( &window, &QQuickWindow::frameSwapped, &window,
+        [&]()
+        {
+            if ( ++frame >= frameCount )
+            {
+                printResult( "Horizontal", hAxis );
+                printResult( "Vertical", vAxis );
+
+                QCoreApplication::quit();
+                return;
+            }
+
+            for ( auto axis : { hAxis, vAxis } )
+            {
+                const auto boundaries = axis->boundaries();
+                axis->setBoundaries( boundaries.translated( step ) );
+            }
+        },
+        Qt::QueuedConnection );
+
+    window.show();
+
+    return app.exec();
+}
@@ -0,0 +1,8 @@
+CONFIG += qskexample
+
+HEADERS += \
+    Axis.h
+
+SOURCES += \
+    Axis.cpp \
+    main.cpp
@@ -211,6 +211,7 @@ void Editor::setupBox()
     setGradient( Q::Panel, m_pal.baseColor );
     setBoxShape( Q::Panel, 4 );
     setBoxBorderMetrics( Q::Panel, 0 );
+    setSpacing( Q::Panel, 5 );
 }
 
 void Editor::setupPopup()
@@ -293,6 +293,7 @@ void Editor::setupControl()
 void Editor::setupBox()
 {
     setPanel( QskBox::Panel, Plain );
+    setSpacing( QskBox::Panel, 5 );
 }
 
 void Editor::setupCheckBox()
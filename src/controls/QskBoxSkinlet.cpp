@@ -5,11 +5,13 @@
 
 #include "QskBoxSkinlet.h"
 #include "QskBox.h"
+#include "QskBoxShapeMetrics.h"
+#include "QskShadowMetrics.h"
 
 QskBoxSkinlet::QskBoxSkinlet( QskSkin* skin )
     : Inherited( skin )
 {
-    setNodeRoles( { PanelRole } );
+    setNodeRoles( { ShadowRole, PanelRole } );
 }
 
 QskBoxSkinlet::~QskBoxSkinlet()
@@ -34,6 +36,21 @@ QSGNode* QskBoxSkinlet::updateSubNode(
 
     switch ( nodeRole )
     {
+        case ShadowRole:
+        {
+            if ( !box->hasPanel() )
+                return nullptr;
+
+            const auto color = box->shadowColorHint( QskBox::Panel );
+            if ( !color.isValid() )
+                return nullptr;
+
+            return updateBoxShadowNode( skinnable, node,
+                box->subControlRect( QskBox::Panel ),
+                box->boxShapeHint( QskBox::Panel ),
+                box->shadowMetricsHint( QskBox::Panel ), color );
+        }
+
         case PanelRole:
         {
             if ( !box->hasPanel() )
@@ -17,6 +17,7 @@ class QSK_EXPORT QskBoxSkinlet : public QskSkinlet
   public:
     enum NodeRole
     {
+        ShadowRole,
         PanelRole,
     };
 
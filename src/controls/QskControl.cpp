@@ -9,6 +9,8 @@
 #include "QskAspect.h"
 #include "QskFunctions.h"
 #include "QskEvent.h"
+#include "QskLayerCache.h"
+#include "QskLayoutProfiler.h"
 #include "QskQuick.h"
 #include "QskSetup.h"
 #include "QskSkin.h"
@@ -102,6 +104,23 @@ bool QskControl::isWheelEnabled() const
     return d_func()->isWheelEnabled;
 }
 
+void QskControl::setLayerCaching( bool on )
+{
+    Q_D( QskControl );
+    if ( on != d->layerCaching )
+    {
+        d->layerCaching = on;
+        QskLayerCache::setEnabled( this, on );
+
+        Q_EMIT layerCachingChanged();
+    }
+}
+
+bool QskControl::hasLayerCaching() const
+{
+    return d_func()->layerCaching;
+}
+
 void QskControl::setFocusPolicy( Qt::FocusPolicy policy )
 {
     Q_D( QskControl );
@@ -599,7 +618,7 @@ QSizeF QskControl::implicitSizeHint(
     }
     else
     {
-        hint = d_func()->implicitSizeHint( whichHint, constraint );
+        hint = d_func()->cachedImplicitSizeHint( whichHint, constraint );
     }
 
     return hint;
@@ -614,6 +633,8 @@ QSizeF QskControl::effectiveSizeHint(
     if ( constraint.isValid() )
         return constraint;
 
+    QskLayoutProfiler::Scope scope( this, QskLayoutProfiler::Scope::SizeHint );
+
     const bool isConstrained =
         constraint.width() >= 0 || constraint.height() >= 0;
 
@@ -848,6 +869,8 @@ void QskControl::updateItemPolish()
 
     if ( width() >= 0.0 || height() >= 0.0 )
     {
+        QskLayoutProfiler::Scope scope( this, QskLayoutProfiler::Scope::Layout );
+
         if ( d_func()->autoLayoutChildren && !maybeUnresized() )
         {
             const auto rect = layoutRect();
@@ -38,6 +38,9 @@ class QSK_EXPORT QskControl : public QskQuickItem, public QskSkinnable
     Q_PROPERTY( bool wheelEnabled READ isWheelEnabled
         WRITE setWheelEnabled NOTIFY wheelEnabledChanged )
 
+    Q_PROPERTY( bool layerCaching READ hasLayerCaching
+        WRITE setLayerCaching NOTIFY layerCachingChanged )
+
     Q_PROPERTY( bool visibleToLayout READ isVisibleToLayout )
 
     Q_PROPERTY( QskMargins margins READ margins
@@ -99,6 +102,10 @@ class QSK_EXPORT QskControl : public QskQuickItem, public QskSkinnable
     void setWheelEnabled( bool );
     bool isWheelEnabled() const;
 
+    // rendering the subtree into a texture, see QskLayerCache
+    void setLayerCaching( bool );
+    bool hasLayerCaching() const;
+
     void setFocusPolicy( Qt::FocusPolicy );
     Qt::FocusPolicy focusPolicy() const;
 
@@ -177,6 +184,7 @@ class QSK_EXPORT QskControl : public QskQuickItem, public QskSkinnable
     void localeChanged( const QLocale& );
     void focusPolicyChanged();
     void wheelEnabledChanged();
+    void layerCachingChanged();
 
   public Q_SLOTS:
     void setLocale( const QLocale& );
@@ -22,6 +22,73 @@ static inline QPointF qskScenePosition( const QMouseEvent* event )
 #endif
 }
 
+/*
+    Hints for other requests than the unconstrained preferred size,
+    that is cached as implicit size. Only allocated, when being needed.
+
+    The entries are valid as long as the layout constraint serial
+    has not changed: resetImplicitSize(), style changes or setting
+    any metric skin hint bump it.
+ */
+class QskControlPrivate::HintCache
+{
+  public:
+    bool find( quint64 serial, Qt::SizeHint which,
+        const QSizeF& constraint, QSizeF& hint ) const
+    {
+        if ( serial != m_serial )
+            return false;
+
+        for ( const auto& entry : m_entries )
+        {
+            if ( entry.which == which && entry.constraint == constraint )
+            {
+                hint = entry.hint;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void insert( quint64 serial, Qt::SizeHint which,
+        const QSizeF& constraint, const QSizeF& hint )
+    {
+        if ( serial != m_serial )
+        {
+            for ( auto& entry : m_entries )
+                entry.which = -1;
+
+            m_serial = serial;
+            m_next = 0;
+        }
+
+        auto& entry = m_entries[ m_next ];
+
+        entry.which = which;
+        entry.constraint = constraint;
+        entry.hint = hint;
+
+        m_next = ( m_next + 1 ) % EntryCount;
+    }
+
+  private:
+    // minimum/maximum + a couple of constraints, f.e. heightForWidth
+    enum { EntryCount = 6 };
+
+    struct Entry
+    {
+        int which = -1;
+        QSizeF constraint;
+        QSizeF hint;
+    };
+
+    Entry m_entries[ EntryCount ];
+
+    quint64 m_serial = 0;
+    int m_next = 0;
+};
+
 /*
     Qt 5.12:
         sizeof( QQuickItemPrivate::ExtraData ) -> 184
@@ -47,6 +114,7 @@ static inline QPointF qskScenePosition( const QMouseEvent* event )
 
 QskControlPrivate::QskControlPrivate()
     : explicitSizeHints( nullptr )
+    , hintCache( nullptr )
     , sizePolicy( QskSizePolicy::Preferred, QskSizePolicy::Preferred )
     , visiblePlacementPolicy( 0 )
     , hiddenPlacementPolicy( 0 )
@@ -56,6 +124,7 @@ QskControlPrivate::QskControlPrivate()
     , autoLayoutChildren( false )
     , focusPolicy( Qt::NoFocus )
     , isWheelEnabled( false )
+    , layerCaching( false )
     , blockLayoutRequestEvents( true )
 {
 }
@@ -63,10 +132,17 @@ QskControlPrivate::QskControlPrivate()
 QskControlPrivate::~QskControlPrivate()
 {
     delete [] explicitSizeHints;
+    delete hintCache;
 }
 
 void QskControlPrivate::layoutConstraintChanged()
 {
+    /*
+        Even when not sending an event the hints might have changed
+        and results, that have been cached by layouts, are outdated.
+     */
+    bumpLayoutConstraintSerial();
+
     if ( !blockLayoutRequestEvents )
     {
         Inherited::layoutConstraintChanged();
@@ -86,6 +162,11 @@ void QskControlPrivate::implicitSizeChanged()
         // when we have no explit size, the implicit size matters
         layoutConstraintChanged();
     }
+    else
+    {
+        // to be on the safe side for cached minimum/maximum hints
+        bumpLayoutConstraintSerial();
+    }
 }
 
 QSizeF QskControlPrivate::implicitSizeHint() const
@@ -182,6 +263,33 @@ QSizeF QskControlPrivate::implicitSizeHint(
     return QSizeF( w, h );
 }
 
+QSizeF QskControlPrivate::cachedImplicitSizeHint(
+    Qt::SizeHint which, const QSizeF& constraint ) const
+{
+    QSizeF hint;
+
+    if ( hintCache && hintCache->find(
+        layoutConstraintSerial(), which, constraint, hint ) )
+    {
+        return hint;
+    }
+
+    hint = implicitSizeHint( which, constraint );
+
+    if ( hintCache == nullptr )
+        hintCache = new HintCache();
+
+    /*
+        Calculating the hint might have changed the serial, f.e when
+        children updated their implicit sizes lazily. The hint has been
+        calculated from the updated state, so we can store it for
+        the current serial.
+     */
+    hintCache->insert( layoutConstraintSerial(), which, constraint, hint );
+
+    return hint;
+}
+
 void QskControlPrivate::setExplicitSizeHint(
     Qt::SizeHint whichHint, const QSizeF& size )
 {
@@ -30,6 +30,9 @@ class QskControlPrivate : public QskQuickItemPrivate
     QSizeF implicitSizeHint( Qt::SizeHint, const QSizeF& ) const;
     QSizeF implicitSizeHint() const override final;
 
+    // cached until the layout constraint serial changes
+    QSizeF cachedImplicitSizeHint( Qt::SizeHint, const QSizeF& ) const;
+
     void implicitSizeChanged() override final;
     void layoutConstraintChanged() override final;
 
@@ -43,6 +46,9 @@ class QskControlPrivate : public QskQuickItemPrivate
 
     QSizeF* explicitSizeHints;
 
+    class HintCache;
+    mutable HintCache* hintCache;
+
     QLocale locale;
 
     QskSizePolicy sizePolicy;
@@ -59,6 +65,7 @@ class QskControlPrivate : public QskQuickItemPrivate
 
     uint focusPolicy : 4;
     bool isWheelEnabled : 1;
+    bool layerCaching : 1;
 
     mutable bool blockLayoutRequestEvents : 1;
 };
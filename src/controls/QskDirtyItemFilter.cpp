@@ -120,11 +120,13 @@ void QskDirtyItemFilter::beforeSynchronizing( QQuickWindow* window )
     }
 }
 
-void QskDirtyItemFilter::filterDirtyList(
-    QQuickWindow* window, bool ( *isBlocked )( const QQuickItem* ) )
+int QskDirtyItemFilter::filterDirtyList( QQuickWindow* window,
+    const std::function< bool( const QQuickItem* ) >& isBlocked )
 {
     if ( window == nullptr )
-        return;
+        return 0;
+
+    int count = 0;
 
     auto d = QQuickWindowPrivate::get( window );
     for ( auto item = d->dirtyItemList; item != nullptr; )
@@ -132,8 +134,13 @@ void QskDirtyItemFilter::filterDirtyList(
         auto nextItem = QQuickItemPrivate::get( item )->nextDirtyItem;
 
         if ( isBlocked( item ) )
+        {
             QQuickItemPrivate::get( item )->removeFromDirtyList();
+            count++;
+        }
 
         item = nextItem;
     }
+
+    return count;
 }
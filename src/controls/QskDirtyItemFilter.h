@@ -11,6 +11,8 @@
 #include <qobject.h>
 #include <qset.h>
 
+#include <functional>
+
 class QQuickWindow;
 class QQuickItem;
 
@@ -24,8 +26,9 @@ class QskDirtyItemFilter : public QObject
 
     void addWindow( QQuickWindow* window );
 
-    static void filterDirtyList( QQuickWindow*,
-        bool ( *isBlocked )( const QQuickItem* ) );
+    // returns the number of items, that have been removed from the list
+    static int filterDirtyList( QQuickWindow*,
+        const std::function< bool( const QQuickItem* ) >& isBlocked );
 
   private:
     void beforeSynchronizing( QQuickWindow* );
@@ -0,0 +1,288 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskLayerCache.h"
+#include "QskControl.h"
+
+#include <qalgorithms.h>
+#include <qglobalstatic.h>
+#include <qhash.h>
+#include <qmutex.h>
+#include <qpointer.h>
+#include <qquickwindow.h>
+#include <qset.h>
+#include <qvarlengtharray.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qquickitem_p.h>
+QSK_QT_PRIVATE_END
+
+/*
+    The last 32 frames are taken into account. A cache, that
+    is dirty in more than half of them, gets disabled.
+ */
+static const int qskMinFrameCount = 32;
+static const int qskMaxDirtyFrames = 16;
+
+// unchanged frames, before a disabled cache is tried again
+static const int qskCleanFramesForReenabling = 120;
+
+static void qskSetLayerEnabled( QskControl* control, bool on )
+{
+    if ( auto layer = QQuickItemPrivate::get( control )->layer() )
+    {
+        layer->setEnabled( on );
+        if ( on )
+            layer->setSmooth( true );
+    }
+}
+
+static bool qskIsSubtreeDirty( const QQuickItem* item )
+{
+    /*
+        An item with modified attributes needs to be synchronized
+        in this frame, what invalidates the texture of the layer.
+        The walk stops at the first dirty item.
+     */
+    const auto d = QQuickItemPrivate::get( item );
+
+    if ( d->dirtyAttributes )
+        return true;
+
+    if ( !d->effectiveVisible )
+        return false;
+
+    for ( const auto child : d->childItems )
+    {
+        if ( qskIsSubtreeDirty( child ) )
+            return true;
+    }
+
+    return false;
+}
+
+namespace
+{
+    class Entry
+    {
+      public:
+        QPointer< QskControl > control;
+
+        quint32 history = 0; // dirty bit for each of the recent frames
+        int frameCount = 0;
+        int cleanFrames = 0;
+
+        bool active = true;
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 autoDisabled = 0;
+    };
+
+    class Monitor final : public QObject
+    {
+      public:
+        void insert( QskControl* control )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            if ( m_entries.contains( control ) )
+                return;
+
+            Entry entry;
+            entry.control = control;
+
+            m_entries.insert( control, entry );
+
+            connect( control, &QObject::destroyed,
+                this, [ this, control ] { remove( control ); } );
+
+            connect( control, &QQuickItem::windowChanged,
+                this, [ this ]( QQuickWindow* window )
+                {
+                    QMutexLocker locker( &m_mutex );
+                    addWindow( window );
+                } );
+
+            addWindow( control->window() );
+        }
+
+        void remove( QskControl* control )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            if ( m_entries.remove( control ) )
+                disconnect( control, nullptr, this, nullptr );
+        }
+
+        QskLayerCache::Statistics statistics( const QskControl* control ) const
+        {
+            QMutexLocker locker( &m_mutex );
+
+            QskLayerCache::Statistics statistics;
+
+            for ( auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it )
+            {
+                if ( control && it.key() != control )
+                    continue;
+
+                const auto& entry = it.value();
+
+                statistics.controlCount++;
+                if ( entry.active )
+                    statistics.activeCount++;
+
+                statistics.hits += entry.hits;
+                statistics.misses += entry.misses;
+                statistics.autoDisabled += entry.autoDisabled;
+            }
+
+            return statistics;
+        }
+
+      private:
+        void addWindow( QQuickWindow* window )
+        {
+            // the mutex has to be locked
+            if ( window == nullptr || m_windows.contains( window ) )
+                return;
+
+            m_windows.insert( window );
+
+            // the dirty state is final, when the scene graph gets synchronized
+
+            connect( window, &QQuickWindow::beforeSynchronizing,
+                this, [ this, window ] { updateEntries( window ); },
+                Qt::DirectConnection );
+
+            connect( window, &QObject::destroyed,
+                this, [ this, window ]
+                {
+                    QMutexLocker locker( &m_mutex );
+                    m_windows.remove( window );
+                } );
+        }
+
+        void updateEntries( QQuickWindow* window )
+        {
+            /*
+                The GUI thread is blocked, so we can inspect the items
+                without holding the lock.
+             */
+            QVarLengthArray< QPair< const QQuickItem*, bool >, 16 > states;
+
+            {
+                QMutexLocker locker( &m_mutex );
+
+                for ( auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it )
+                {
+                    const auto& control = it.value().control;
+                    if ( control && control->window() == window )
+                        states += qMakePair( it.key(), false );
+                }
+            }
+
+            if ( states.isEmpty() )
+                return;
+
+            for ( auto& state : states )
+                state.second = qskIsSubtreeDirty( state.first );
+
+            QMutexLocker locker( &m_mutex );
+
+            for ( const auto& state : qAsConst( states ) )
+            {
+                auto it = m_entries.find( state.first );
+                if ( it == m_entries.end() )
+                    continue;
+
+                auto& entry = it.value();
+                const bool isDirty = state.second;
+
+                if ( entry.active )
+                {
+                    if ( isDirty )
+                        entry.misses++;
+                    else
+                        entry.hits++;
+
+                    entry.history = ( entry.history << 1 ) | ( isDirty ? 1 : 0 );
+                    entry.frameCount++;
+
+                    if ( entry.frameCount >= qskMinFrameCount
+                        && qPopulationCount( entry.history ) > qskMaxDirtyFrames )
+                    {
+                        entry.active = false;
+                        entry.autoDisabled++;
+                        entry.cleanFrames = 0;
+
+                        scheduleLayerEnabled( entry.control, false );
+                    }
+                }
+                else
+                {
+                    entry.cleanFrames = isDirty ? 0 : entry.cleanFrames + 1;
+
+                    if ( entry.cleanFrames >= qskCleanFramesForReenabling )
+                    {
+                        entry.active = true;
+                        entry.history = 0;
+                        entry.frameCount = 0;
+
+                        scheduleLayerEnabled( entry.control, true );
+                    }
+                }
+            }
+        }
+
+        void scheduleLayerEnabled( QskControl* control, bool on )
+        {
+            /*
+                We might be in the scene graph thread, but the layer
+                creates items and has to be modified in the GUI thread.
+             */
+            QPointer< QskControl > ptr( control );
+
+            QMetaObject::invokeMethod( control,
+                [ ptr, on ]
+                {
+                    // caching might have been disabled in the meantime
+                    if ( ptr && ( !on || ptr->hasLayerCaching() ) )
+                        qskSetLayerEnabled( ptr, on );
+                },
+                Qt::QueuedConnection );
+        }
+
+        mutable QMutex m_mutex;
+
+        QHash< const QQuickItem*, Entry > m_entries;
+        QSet< const QQuickWindow* > m_windows;
+    };
+}
+
+Q_GLOBAL_STATIC( Monitor, qskMonitor )
+
+void QskLayerCache::setEnabled( QskControl* control, bool on )
+{
+    if ( on )
+        qskMonitor->insert( control );
+    else
+        qskMonitor->remove( control );
+
+    qskSetLayerEnabled( control, on );
+}
+
+QskLayerCache::Statistics QskLayerCache::statistics( const QskControl* control )
+{
+    if ( control == nullptr )
+        return Statistics();
+
+    return qskMonitor->statistics( control );
+}
+
+QskLayerCache::Statistics QskLayerCache::globalStatistics()
+{
+    return qskMonitor->statistics( nullptr );
+}
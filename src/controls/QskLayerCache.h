@@ -0,0 +1,51 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_LAYER_CACHE_H
+#define QSK_LAYER_CACHE_H
+
+#include "QskGlobal.h"
+
+class QskControl;
+
+/*
+    Controls with layer caching enabled - see QskControl::setLayerCaching -
+    render their subtree into a texture, that is reused until one of
+    the items of the subtree gets updated.
+
+    For each frame it is checked if the subtree is dirty. When this is the
+    case for more than half of the recent frames the layer is considered
+    as being counterproductive and gets disabled, until the subtree has
+    been unchanged for a while.
+ */
+class QSK_EXPORT QskLayerCache
+{
+  public:
+    class Statistics
+    {
+      public:
+        int controlCount = 0;
+        int activeCount = 0; // not disabled by the heuristics
+
+        // frames, where the texture was reused or had to be rendered
+        quint64 hits = 0;
+        quint64 misses = 0;
+
+        // how often the heuristics had disabled the cache
+        quint64 autoDisabled = 0;
+    };
+
+    static Statistics statistics( const QskControl* );
+
+    // accumulated over all controls
+    static Statistics globalStatistics();
+
+  private:
+    friend class QskControl;
+
+    static void setEnabled( QskControl*, bool );
+};
+
+#endif
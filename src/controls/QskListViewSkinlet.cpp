@@ -8,6 +8,7 @@
 
 #include "QskColorFilter.h"
 #include "QskGraphic.h"
+#include "QskNodePool.h"
 #include "QskSGNode.h"
 #include "QskSkinStateChanger.h"
 
@@ -194,7 +195,9 @@ void QskListViewSkinlet::updateForegroundNodes(
 
     if ( listView->rowCount() <= 0 || listView->columnCount() <= 0 )
     {
-        parentNode->removeAllChildNodes();
+        while ( auto childNode = parentNode->firstChild() )
+            QskNodePool::release( childNode );
+
         listViewNode->invalidate();
         return;
     }
@@ -302,7 +305,7 @@ void QskListViewSkinlet::updateVisibleForegroundNodes(
     if ( forward )
     {
         for ( int i = 0; i < obsoleteNodesCount; i++ )
-            delete parentNode->lastChild();
+            QskNodePool::release( parentNode->lastChild() );
 
         auto node = parentNode->firstChild();
 
@@ -325,7 +328,7 @@ void QskListViewSkinlet::updateVisibleForegroundNodes(
     else
     {
         for ( int i = 0; i < obsoleteNodesCount; i++ )
-            delete parentNode->firstChild();
+            QskNodePool::release( parentNode->firstChild() );
 
         auto* node = parentNode->lastChild();
 
@@ -372,7 +375,7 @@ QSGTransformNode* QskListViewSkinlet::updateForegroundNode(
             }
             else
             {
-                newCellNode = new QSGTransformNode();
+                newCellNode = QskNodePool::createTransformNode();
                 newCellNode->appendChildNode( newNode );
             }
         }
@@ -392,14 +395,14 @@ QSGTransformNode* QskListViewSkinlet::updateForegroundNode(
             {
                 if ( cellNode == nullptr )
                 {
-                    newCellNode = new QSGTransformNode();
+                    newCellNode = QskNodePool::createTransformNode();
                     newCellNode->appendChildNode( newNode );
                 }
                 else
                 {
                     if ( newNode != oldNode )
                     {
-                        delete cellNode->firstChild();
+                        QskNodePool::release( cellNode->firstChild() );
                         cellNode->appendChildNode( newNode );
 
                         newCellNode = cellNode;
@@ -410,14 +413,14 @@ QSGTransformNode* QskListViewSkinlet::updateForegroundNode(
     }
 
     if ( newCellNode == nullptr )
-        newCellNode = new QSGTransformNode();
+        newCellNode = QskNodePool::createTransformNode();
 
     if ( cellNode != newCellNode )
     {
         if ( cellNode )
         {
             parentNode->insertChildNodeAfter( newCellNode, cellNode );
-            delete cellNode;
+            QskNodePool::release( cellNode );
         }
         else
         {
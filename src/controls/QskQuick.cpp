@@ -6,6 +6,8 @@
 #include "QskQuick.h"
 #include "QskControl.h"
 #include "QskFunctions.h"
+#include "QskLayoutProfiler.h"
+#include "QskQuickItemPrivate.h"
 #include <qquickitem.h>
 
 QSK_QT_PRIVATE_BEGIN
@@ -30,6 +32,8 @@ QRectF qskItemGeometry( const QQuickItem* item )
 
 void qskSetItemGeometry( QQuickItem* item, const QRectF& rect )
 {
+    QskLayoutProfiler::countGeometryAssignment();
+
     if ( auto control = qskControlCast( item ) )
     {
         control->setGeometry( rect );
@@ -157,6 +161,23 @@ Qt::Alignment qskLayoutAlignmentHint( const QQuickItem* item )
     return Qt::Alignment();
 }
 
+quint64 qskLayoutConstraintSerial( const QQuickItem* item )
+{
+    /*
+        Other items might have hints from dynamic properties
+        or implicit sizes, that are changed without notification.
+     */
+    if ( auto control = qskControlCast( item ) )
+    {
+        auto d = static_cast< const QskQuickItemPrivate* >(
+            QQuickItemPrivate::get( control ) );
+
+        return d->layoutConstraintSerial();
+    }
+
+    return 0;
+}
+
 void qskSetPlacementPolicy( QQuickItem* item, const QskPlacementPolicy policy )
 {
     if ( item == nullptr )
@@ -656,6 +677,24 @@ void qskItemUpdateRecursive( QQuickItem* item )
         qskItemUpdateRecursive( child );
 }
 
+void qskReleaseNodesRecursive( QQuickItem* item )
+{
+    if ( item == nullptr || item->isVisible() )
+        return;
+
+    if ( qobject_cast< QskQuickItem* >( item ) )
+    {
+        auto d = static_cast< QskQuickItemPrivate* >(
+            QQuickItemPrivate::get( item ) );
+
+        d->cleanupNodes();
+    }
+
+    const auto& children = QQuickItemPrivate::get( item )->childItems;
+    for ( auto child : children )
+        qskReleaseNodesRecursive( child );
+}
+
 #if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
 
 static const QQuickPointerTouchEvent* qskPointerPressEvent( const QQuickWindowPrivate* wd )
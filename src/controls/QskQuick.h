@@ -48,6 +48,12 @@ QSK_EXPORT QRectF qskConstrainedItemRect(
 QSK_EXPORT QskSizePolicy qskSizePolicy( const QQuickItem* );
 QSK_EXPORT Qt::Alignment qskLayoutAlignmentHint( const QQuickItem* );
 
+/*
+    A serial, that changes whenever the layout hints of a control might
+    have changed. 0 for items, that don't track their changes.
+ */
+QSK_EXPORT quint64 qskLayoutConstraintSerial( const QQuickItem* );
+
 QSK_EXPORT QskPlacementPolicy qskPlacementPolicy( const QQuickItem* );
 QSK_EXPORT void qskSetPlacementPolicy( QQuickItem*, QskPlacementPolicy );
 
@@ -71,6 +77,13 @@ QSK_EXPORT const QSGNode* qskPaintNode( const QQuickItem* );
 
 QSK_EXPORT void qskItemUpdateRecursive( QQuickItem* );
 
+/*
+    Releasing the scene graph nodes of a hidden item and its children,
+    like it is done for QskQuickItem::CleanupOnVisibility. Only nodes
+    of QskQuickItems can be released.
+ */
+QSK_EXPORT void qskReleaseNodesRecursive( QQuickItem* );
+
 QSK_EXPORT bool qskGrabMouse( QQuickItem* );
 QSK_EXPORT void qskUngrabMouse( QQuickItem* );
 QSK_EXPORT bool qskIsMouseGrabber( const QQuickItem* );
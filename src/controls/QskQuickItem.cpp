@@ -10,9 +10,16 @@
 #include "QskSetup.h"
 #include "QskSkin.h"
 #include "QskDirtyItemFilter.h"
+#include "QskNodePool.h"
 
 #include <qglobalstatic.h>
+#include <qpointer.h>
 #include <qquickwindow.h>
+#include <qvarlengtharray.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qquickwindow_p.h>
+QSK_QT_PRIVATE_END
 
 #if defined( QT_DEBUG )
 
@@ -34,6 +41,55 @@ QSK_QT_PRIVATE_END
 
 #include <unordered_set>
 
+// the type of QQuickWindowPrivate::itemsToPolish differs between Qt versions
+
+template< typename T >
+static inline void qskRemoveItem( QSet< T >& items, const T& item )
+{
+    items.remove( item );
+}
+
+template< typename T >
+static inline void qskRemoveItem( QVector< T >& items, const T& item )
+{
+    items.removeOne( item );
+}
+
+template< typename T >
+static inline void qskRemoveItem( QList< T >& items, const T& item )
+{
+    items.removeOne( item );
+}
+
+static QskQuickItem* qskScheduledAncestor( const QQuickItem* item )
+{
+    // the topmost ancestor, that is waiting for being polished
+
+    QskQuickItem* ancestor = nullptr;
+
+    for ( auto it = item->parentItem(); it; it = it->parentItem() )
+    {
+        if ( QQuickItemPrivate::get( it )->polishScheduled )
+        {
+            if ( auto qskItem = qobject_cast< QskQuickItem* >( it ) )
+                ancestor = qskItem;
+        }
+    }
+
+    return ancestor;
+}
+
+static void qskUnschedulePolish( QQuickItem* item )
+{
+    QQuickItemPrivate::get( item )->polishScheduled = false;
+
+    if ( auto window = item->window() )
+    {
+        auto wd = QQuickWindowPrivate::get( window );
+        qskRemoveItem( wd->itemsToPolish, item );
+    }
+}
+
 static inline void qskSendEventTo( QObject* object, QEvent::Type type )
 {
     QEvent event( type );
@@ -169,6 +225,9 @@ QskQuickItem::QskQuickItem( QskQuickItemPrivate& dd, QQuickItem* parent )
     if ( dd.updateFlags & QskQuickItem::DeferredUpdate )
         qskFilterWindow( window() );
 
+    // recycling nodes instead of deleting them
+    QskNodePool::attachWindow( window() );
+
     qskRegistry->insert( this );
 }
 
@@ -569,6 +628,13 @@ void QskQuickItem::resetImplicitSize()
 {
     Q_D( QskQuickItem );
 
+    /*
+        Even if the implicit size does not change, other hints
+        might do so. So we always need to invalidate hints,
+        that have been cached by the control or by layouts.
+     */
+    d->bumpLayoutConstraintSerial();
+
     if ( d->updateFlags & QskQuickItem::DeferredLayout )
     {
         d->blockedImplicitSize = true;
@@ -710,6 +776,8 @@ void QskQuickItem::itemChange( QQuickItem::ItemChange change,
                 Q_D( const QskQuickItem );
                 if ( d->updateFlags & QskQuickItem::DeferredUpdate )
                     qskFilterWindow( changeData.window );
+
+                QskNodePool::attachWindow( changeData.window );
             }
 
 #if 1
@@ -909,6 +977,34 @@ void QskQuickItem::updatePolish()
 
     d->blockedPolish = false;
 
+    /*
+        The list of items to-be-polished is not processed in top/down order.
+        When an ancestor is still waiting for its layout, it will probably
+        assign a new geometry and we would have to run into another
+        updatePolish(). So we polish the ancestors first and skip our own
+        layout, when having been rescheduled by them.
+     */
+    QVarLengthArray< const QskQuickItem*, 8 > ancestors;
+
+    while ( auto ancestor = qskScheduledAncestor( this ) )
+    {
+        if ( ancestors.contains( ancestor ) )
+            break; // an ancestor, that keeps rescheduling itself
+
+        ancestors += ancestor;
+
+        QPointer< QskQuickItem > that = this;
+
+        qskUnschedulePolish( ancestor );
+        ancestor->updatePolish();
+
+        if ( that.isNull() )
+            return; // deleted by the layout of the ancestor
+
+        if ( d->polishScheduled )
+            return; // we will be polished later with our final geometry
+    }
+
     if ( !d->initiallyPainted )
     {
         /*
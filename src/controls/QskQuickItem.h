@@ -43,6 +43,8 @@ class QSK_EXPORT QskQuickItem : public QQuickItem
         CleanupOnVisibility     =  1 << 3,
 
         PreferRasterForTextures =  1 << 4,
+        AsynchronousTextures    =  1 << 5,
+        TessellateGraphics      =  1 << 6,
 
         DebugForceBackground    =  1 << 7
     };
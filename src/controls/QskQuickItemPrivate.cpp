@@ -4,8 +4,15 @@
  *****************************************************************************/
 
 #include "QskQuickItemPrivate.h"
+#include "QskLayoutProfiler.h"
 #include "QskSetup.h"
 
+/*
+    Serials are unique over all items, so that a serial can't be confused
+    with the one of a deleted item, that was living at the same address.
+ */
+static quint64 qskConstraintSerialCounter = 0;
+
 static inline void qskSendEventTo( QObject* object, QEvent::Type type )
 {
     QEvent event( type );
@@ -13,7 +20,8 @@ static inline void qskSendEventTo( QObject* object, QEvent::Type type )
 }
 
 QskQuickItemPrivate::QskQuickItemPrivate()
-    : updateFlags( qskSetup->itemUpdateFlags() )
+    : constraintSerial( ++qskConstraintSerialCounter )
+    , updateFlags( qskSetup->itemUpdateFlags() )
     , updateFlagsMask( 0 )
     , polishOnResize( false )
     , blockedPolish( false )
@@ -82,10 +90,21 @@ void QskQuickItemPrivate::applyUpdateFlags( QskQuickItem::UpdateFlags flags )
         Q_EMIT q->updateFlagsChanged( q->updateFlags() );
 }
 
+void QskQuickItemPrivate::bumpLayoutConstraintSerial()
+{
+    // layouting is done in the GUI thread only
+    constraintSerial = ++qskConstraintSerialCounter;
+}
+
 void QskQuickItemPrivate::layoutConstraintChanged()
 {
+    bumpLayoutConstraintSerial();
+
     if ( auto item = q_func()->parentItem() )
+    {
+        QskLayoutProfiler::countLayoutRequest( q_func(), item );
         qskSendEventTo( item, QEvent::LayoutRequest );
+    }
 }
 
 void QskQuickItemPrivate::implicitSizeChanged()
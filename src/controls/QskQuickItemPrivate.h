@@ -24,13 +24,18 @@ class QskQuickItemPrivate : public QQuickItemPrivate
   public:
     void applyUpdateFlags( QskQuickItem::UpdateFlags );
 
+    // changes whenever the item might have different layout hints
+    inline quint64 layoutConstraintSerial() const { return constraintSerial; }
+    void bumpLayoutConstraintSerial();
+
+    // nodes will be recreated with the next scene graph update
+    void cleanupNodes();
+
   protected:
     virtual void layoutConstraintChanged();
     virtual void implicitSizeChanged();
 
   private:
-
-    void cleanupNodes();
     void mirrorChange() override;
 
     qreal getImplicitWidth() const override final;
@@ -47,6 +52,8 @@ class QskQuickItemPrivate : public QQuickItemPrivate
   private:
     Q_DECLARE_PUBLIC( QskQuickItem )
 
+    quint64 constraintSerial;
+
     quint8 updateFlags;
     quint8 updateFlagsMask;
 
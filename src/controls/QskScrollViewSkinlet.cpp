@@ -7,6 +7,9 @@
 #include "QskScrollView.h"
 
 #include "QskAspect.h"
+#include "QskBoxBorderMetrics.h"
+#include "QskBoxClipNode.h"
+#include "QskBoxShapeMetrics.h"
 #include "QskQuick.h"
 #include "QskSGNode.h"
 
@@ -38,6 +41,19 @@ static void qskAlignedHandle( qreal start, qreal end,
     }
 }
 
+static inline QRectF qskContentsRect( const QskScrollView* scrollView )
+{
+    /*
+        The area, where the content is painted. As content nodes often
+        fill the complete viewport - f.e the rows of a list view - we
+        don't rely on the scrollable size only.
+     */
+    const auto rect = scrollView->viewContentsRect();
+    const auto size = scrollView->scrollableSize().expandedTo( rect.size() );
+
+    return QRectF( rect.topLeft() - scrollView->scrollPos(), size );
+}
+
 QskScrollViewSkinlet::QskScrollViewSkinlet( QskSkin* skin )
     : Inherited( skin )
 {
@@ -126,13 +142,66 @@ QSGNode* QskScrollViewSkinlet::updateSubNode(
 QSGNode* QskScrollViewSkinlet::updateContentsRootNode(
     const QskScrollView* scrollView, QSGNode* node ) const
 {
-    auto* clipNode = updateBoxClipNode( scrollView, node, QskScrollView::Viewport );
-    if ( clipNode == nullptr )
-        return nullptr;
+    using Q = QskScrollView;
+
+    QSGNode* oldContentsNode = nullptr;
+    if ( node )
+        oldContentsNode = QskSGNode::findChildNode( node, ContentsRootRole );
 
-    auto oldContentsNode = QskSGNode::findChildNode( clipNode, ContentsRootRole );
     auto contentsNode = updateContentsNode( scrollView, oldContentsNode );
 
+    const auto clipRect = scrollView->subControlRect( Q::Viewport )
+        .marginsRemoved( scrollView->marginHint( Q::Viewport ) );
+
+    const auto shape = scrollView->boxShapeHint(
+        Q::Viewport ).toAbsolute( clipRect.size() );
+
+    const auto borderMetrics = scrollView->boxBorderMetricsHint(
+        Q::Viewport ).toAbsolute( clipRect.size() );
+
+    /*
+        Without knowing where the content is painted we always need
+        to clip. F.e QskScrollArea has no content node and copies the
+        clip node for its own clip item.
+     */
+    QRectF contentsRect;
+    if ( contentsNode )
+        contentsRect = qskContentsRect( scrollView );
+
+    QSGNode* rootNode;
+
+    if ( !clipRect.isEmpty() && QskBoxClipNode::clipMode( clipRect,
+        shape, borderMetrics, contentsRect ) == QskBoxClipNode::NoClip )
+    {
+        /*
+            The content fits into the viewport. Without a clip node the
+            scene graph is able to batch it with the nodes outside.
+         */
+        rootNode = node;
+        if ( rootNode == nullptr || rootNode->type() != QSGNode::BasicNodeType )
+            rootNode = new QSGNode();
+    }
+    else
+    {
+        QskBoxClipNode* clipNode = nullptr;
+        if ( node && node->type() == QSGNode::ClipNodeType )
+            clipNode = static_cast< QskBoxClipNode* >( node );
+
+        if ( clipNode == nullptr )
+            clipNode = new QskBoxClipNode();
+
+        if ( clipRect.isEmpty() )
+        {
+            clipNode->setRect( clipRect );
+        }
+        else
+        {
+            clipNode->setBox( clipRect, shape, borderMetrics, contentsRect );
+        }
+
+        rootNode = clipNode;
+    }
+
     if ( contentsNode )
     {
         /*
@@ -144,19 +213,25 @@ QSGNode* QskScrollViewSkinlet::updateContentsRootNode(
          */
         QskSGNode::setNodeRole( contentsNode, ContentsRootRole );
 
-        if ( contentsNode->parent() != clipNode )
-            clipNode->appendChildNode( contentsNode );
+        if ( contentsNode->parent() != rootNode )
+        {
+            if ( auto parentNode = contentsNode->parent() )
+                parentNode->removeChildNode( contentsNode );
+
+            rootNode->appendChildNode( contentsNode );
+        }
     }
 
     if ( oldContentsNode && oldContentsNode != contentsNode )
     {
-        clipNode->removeChildNode( oldContentsNode );
+        if ( auto parentNode = oldContentsNode->parent() )
+            parentNode->removeChildNode( oldContentsNode );
 
         if ( oldContentsNode->flags() & QSGNode::OwnedByParent )
             delete oldContentsNode;
     }
 
-    return clipNode;
+    return rootNode;
 }
 
 QSGNode* QskScrollViewSkinlet::updateContentsNode(
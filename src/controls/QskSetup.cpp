@@ -38,6 +38,12 @@ static inline const QskQuickItem::UpdateFlags qskEnvironmentUpdateFlags()
     if ( qskHasEnvironment( "QSK_PREFER_RASTER" ) )
         flags |= QskQuickItem::PreferRasterForTextures;
 
+    if ( qskHasEnvironment( "QSK_ASYNC_TEXTURES" ) )
+        flags |= QskQuickItem::AsynchronousTextures;
+
+    if ( qskHasEnvironment( "QSK_TESSELLATE_GRAPHICS" ) )
+        flags |= QskQuickItem::TessellateGraphics;
+
     if ( qskHasEnvironment( "QSK_FORCE_BACKGROUND" ) )
         flags |= QskQuickItem::DebugForceBackground;
 
@@ -11,6 +11,7 @@
 #include "QskBoxShapeMetrics.h"
 #include "QskBoxBorderMetrics.h"
 #include "QskBoxBorderColors.h"
+#include "QskShadowMetrics.h"
 #include "QskGradient.h"
 
 namespace
@@ -114,6 +115,11 @@ namespace
     {
         return aspect | QskAspect::Border;
     }
+
+    inline QskAspect aspectShadow( QskAspect aspect )
+    {
+        return aspect | QskAspect::Shadow;
+    }
 }
 
 QskSkinHintTableEditor::QskSkinHintTableEditor( QskSkinHintTable* table )
@@ -514,3 +520,37 @@ QskArcMetrics QskSkinHintTableEditor::arcMetrics( QskAspect aspect ) const
 {
     return metricHint< QskArcMetrics >( aspectShape( aspect ) );
 }
+
+void QskSkinHintTableEditor::setShadowMetrics( QskAspect aspect,
+    const QskShadowMetrics& shadowMetrics, QskStateCombination combination )
+{
+    setMetricHint( aspectShadow( aspect ), shadowMetrics, combination );
+}
+
+bool QskSkinHintTableEditor::removeShadowMetrics( QskAspect aspect,
+    QskStateCombination combination )
+{
+    return removeMetricHint( aspectShadow( aspect ), combination );
+}
+
+QskShadowMetrics QskSkinHintTableEditor::shadowMetrics( QskAspect aspect ) const
+{
+    return metricHint< QskShadowMetrics >( aspectShadow( aspect ) );
+}
+
+void QskSkinHintTableEditor::setShadowColor( QskAspect aspect,
+    const QColor& color, QskStateCombination combination )
+{
+    setColorHint( aspectShadow( aspect ), color, combination );
+}
+
+bool QskSkinHintTableEditor::removeShadowColor( QskAspect aspect,
+    QskStateCombination combination )
+{
+    return removeColorHint( aspectShadow( aspect ), combination );
+}
+
+QColor QskSkinHintTableEditor::shadowColor( QskAspect aspect ) const
+{
+    return colorHint< QColor >( aspectShadow( aspect ) );
+}
@@ -20,6 +20,7 @@ class QskGradient;
 class QskBoxShapeMetrics;
 class QskBoxBorderMetrics;
 class QskBoxBorderColors;
+class QskShadowMetrics;
 
 class QSK_EXPORT QskSkinHintTableEditor
 {
@@ -245,6 +246,24 @@ class QSK_EXPORT QskSkinHintTableEditor
 
     QskArcMetrics arcMetrics( QskAspect ) const;
 
+    // shadowMetrics
+
+    void setShadowMetrics( QskAspect,
+        const QskShadowMetrics&, QskStateCombination = QskStateCombination() );
+
+    bool removeShadowMetrics( QskAspect, QskStateCombination = QskStateCombination() );
+
+    QskShadowMetrics shadowMetrics( QskAspect ) const;
+
+    // shadowColor
+
+    void setShadowColor( QskAspect,
+        const QColor&, QskStateCombination = QskStateCombination() );
+
+    bool removeShadowColor( QskAspect, QskStateCombination = QskStateCombination() );
+
+    QColor shadowColor( QskAspect ) const;
+
   private:
     QskSkinHintTable* m_table = nullptr;
 };
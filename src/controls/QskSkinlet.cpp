@@ -11,6 +11,7 @@
 #include "QskBoxBorderMetrics.h"
 #include "QskBoxClipNode.h"
 #include "QskBoxNode.h"
+#include "QskBoxShadowNode.h"
 #include "QskBoxShapeMetrics.h"
 #include "QskBoxHints.h"
 #include "QskColorFilter.h"
@@ -19,10 +20,14 @@
 #include "QskGradient.h"
 #include "QskGraphicNode.h"
 #include "QskGraphic.h"
+#include "QskGraphicTessellator.h"
+#include "QskNodePool.h"
 #include "QskSGNode.h"
+#include "QskShadowMetrics.h"
 #include "QskTextColors.h"
 #include "QskTextNode.h"
 #include "QskTextOptions.h"
+#include "QskVectorGraphicNode.h"
 #include "QskSkinStateChanger.h"
 
 #include <qquickwindow.h>
@@ -74,16 +79,34 @@ static inline QSGNode* qskUpdateGraphicNode(
     if ( control == nullptr )
         return nullptr;
 
+    const auto r = qskSceneAlignedRect( control, rect );
+
+    if ( control->testUpdateFlag( QskControl::TessellateGraphics )
+        && QskGraphicTessellator::isSupported( graphic ) )
+    {
+        auto vectorNode = dynamic_cast< QskVectorGraphicNode* >( node );
+        if ( vectorNode == nullptr )
+            vectorNode = new QskVectorGraphicNode();
+
+        vectorNode->setGraphic( graphic, colorFilter, r, mirrored,
+            control->window()->effectiveDevicePixelRatio() );
+
+        return vectorNode;
+    }
+
     auto mode = QskTextureRenderer::OpenGL;
 
-    auto graphicNode = static_cast< QskGraphicNode* >( node );
+    // the node might have been a QskVectorGraphicNode before
+    auto graphicNode = dynamic_cast< QskGraphicNode* >( node );
     if ( graphicNode == nullptr )
-        graphicNode = new QskGraphicNode();
+        graphicNode = QskNodePool::createGraphicNode();
 
     if ( control->testUpdateFlag( QskControl::PreferRasterForTextures ) )
         mode = QskTextureRenderer::Raster;
 
-    const auto r = qskSceneAlignedRect( control, rect );
+    graphicNode->setAsynchronous(
+        control->testUpdateFlag( QskControl::AsynchronousTextures ) );
+
     graphicNode->setGraphic( control->window(), graphic,
         colorFilter, mode, r, mirrored );
 
@@ -142,7 +165,7 @@ static inline QSGNode* qskUpdateBoxNode(
     {
         auto boxNode = static_cast< QskBoxNode* >( node );
         if ( boxNode == nullptr )
-            boxNode = new QskBoxNode();
+            boxNode = QskNodePool::createBoxNode();
 
         const auto absoluteShape = shape.toAbsolute( rect.size() );
 
@@ -287,7 +310,7 @@ QSGNode* QskSkinlet::updateBackgroundNode(
 
     auto boxNode = static_cast< QskBoxNode* >( node );
     if ( boxNode == nullptr )
-        boxNode = new QskBoxNode();
+        boxNode = QskNodePool::createBoxNode();
 
     boxNode->setBoxData( rect, gradient );
     return boxNode;
@@ -385,6 +408,28 @@ QSGNode* QskSkinlet::updateBoxNode( const QskSkinnable* skinnable,
         hints.shape, hints.borderMetrics, hints.borderColors, hints.gradient );
 }
 
+QSGNode* QskSkinlet::updateBoxShadowNode(
+    const QskSkinnable* skinnable, QSGNode* node, const QRectF& rect,
+    const QskBoxShapeMetrics& shape, const QskShadowMetrics& shadowMetrics,
+    const QColor& color )
+{
+    const auto control = skinnable->owningControl();
+    if ( control == nullptr || control->window() == nullptr )
+        return nullptr;
+
+    if ( rect.isEmpty() || !color.isValid() || color.alpha() == 0 )
+        return nullptr;
+
+    auto shadowNode = static_cast< QskBoxShadowNode* >( node );
+    if ( shadowNode == nullptr )
+        shadowNode = new QskBoxShadowNode();
+
+    shadowNode->setShadowData( control->window(),
+        rect, shape, shadowMetrics, color );
+
+    return shadowNode;
+}
+
 QSGNode* QskSkinlet::updateInterpolatedBoxNode(
     const QskSkinnable* skinnable, QSGNode* node, const QRectF& rect,
     QskAspect aspect1, QskAspect aspect2, qreal ratio )
@@ -504,8 +549,7 @@ QSGNode* QskSkinlet::updateBoxClipNode( const QskSkinnable* skinnable,
     const auto clipRect = rect.marginsRemoved( margins );
     if ( clipRect.isEmpty() )
     {
-        clipNode->setIsRectangular( true );
-        clipNode->setClipRect( clipRect );
+        clipNode->setRect( clipRect );
     }
     else
     {
@@ -532,7 +576,7 @@ QSGNode* QskSkinlet::updateTextNode(
 
     auto textNode = static_cast< QskTextNode* >( node );
     if ( textNode == nullptr )
-        textNode = new QskTextNode();
+        textNode = QskNodePool::createTextNode();
 
     const auto colors = qskTextColors( skinnable, subControl );
 
@@ -25,7 +25,9 @@ class QskBoxShapeMetrics;
 class QskBoxBorderMetrics;
 class QskBoxBorderColors;
 class QskBoxHints;
+class QskShadowMetrics;
 
+class QColor;
 class QSGNode;
 
 class QSK_EXPORT QskSkinlet
@@ -84,6 +86,10 @@ class QSK_EXPORT QskSkinlet
     static QSGNode* updateBoxNode( const QskSkinnable*, QSGNode*,
         const QRectF&, const QskBoxHints& );
 
+    static QSGNode* updateBoxShadowNode( const QskSkinnable*, QSGNode*,
+        const QRectF&, const QskBoxShapeMetrics&,
+        const QskShadowMetrics&, const QColor& );
+
     static QSGNode* updateInterpolatedBoxNode(
         const QskSkinnable*, QSGNode*, const QRectF&,
         QskAspect aspect1, QskAspect aspect2, qreal ratio );
@@ -23,6 +23,7 @@
 #include "QskBoxBorderMetrics.h"
 #include "QskBoxBorderColors.h"
 #include "QskBoxHints.h"
+#include "QskShadowMetrics.h"
 #include "QskGradient.h"
 
 #include <qfont.h>
@@ -582,6 +583,42 @@ QskBoxHints QskSkinnable::boxHints( QskAspect aspect ) const
         boxBorderColorsHint( aspect ), gradientHint( aspect ) );
 }
 
+bool QskSkinnable::setShadowMetricsHint(
+    const QskAspect aspect, const QskShadowMetrics& metrics )
+{
+    return qskSetMetric( this, aspect | QskAspect::Shadow, metrics );
+}
+
+bool QskSkinnable::resetShadowMetricsHint( const QskAspect aspect )
+{
+    return resetMetric( aspect | QskAspect::Shadow );
+}
+
+QskShadowMetrics QskSkinnable::shadowMetricsHint(
+    const QskAspect aspect, QskSkinHintStatus* status ) const
+{
+    return qskMetric< QskShadowMetrics >(
+        this, aspect | QskAspect::Shadow, status );
+}
+
+bool QskSkinnable::setShadowColorHint(
+    const QskAspect aspect, const QColor& color )
+{
+    return qskSetColor( this, aspect | QskAspect::Shadow, color );
+}
+
+bool QskSkinnable::resetShadowColorHint( const QskAspect aspect )
+{
+    return resetColor( aspect | QskAspect::Shadow );
+}
+
+QColor QskSkinnable::shadowColorHint(
+    const QskAspect aspect, QskSkinHintStatus* status ) const
+{
+    return qskColor< QColor >(
+        this, aspect | QskAspect::Shadow, status );
+}
+
 bool QskSkinnable::setArcMetricsHint(
     const QskAspect aspect, const QskArcMetrics& arc )
 {
@@ -29,6 +29,7 @@ class QskBoxShapeMetrics;
 class QskBoxBorderMetrics;
 class QskBoxBorderColors;
 class QskBoxHints;
+class QskShadowMetrics;
 class QskGradient;
 
 class QskSkin;
@@ -210,6 +211,14 @@ class QSK_EXPORT QskSkinnable
 
     QskBoxHints boxHints( QskAspect ) const;
 
+    bool setShadowMetricsHint( QskAspect, const QskShadowMetrics& );
+    bool resetShadowMetricsHint( QskAspect );
+    QskShadowMetrics shadowMetricsHint( QskAspect, QskSkinHintStatus* = nullptr ) const;
+
+    bool setShadowColorHint( QskAspect, const QColor& );
+    bool resetShadowColorHint( QskAspect );
+    QColor shadowColorHint( QskAspect, QskSkinHintStatus* = nullptr ) const;
+
     bool setArcMetricsHint( QskAspect, const QskArcMetrics& );
     bool resetArcMetricsHint( QskAspect );
     QskArcMetrics arcMetricsHint( QskAspect, QskSkinHintStatus* = nullptr ) const;
@@ -4,11 +4,23 @@
  *****************************************************************************/
 
 #include "QskSubWindowArea.h"
+#include "QskBoxBorderMetrics.h"
+#include "QskBoxShapeMetrics.h"
+#include "QskDirtyItemFilter.h"
 #include "QskEvent.h"
+#include "QskGradient.h"
 #include "QskPlatform.h"
 #include "QskSubWindow.h"
 
+#include <qpointer.h>
+#include <qquickwindow.h>
+#include <qset.h>
 #include <qtimer.h>
+#include <qvector.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qquickitem_p.h>
+QSK_QT_PRIVATE_END
 
 QSK_SUBCONTROL( QskSubWindowArea, Panel )
 
@@ -24,6 +36,116 @@ static void qskUpdateEventFilter( QskSubWindowArea* area )
     }
 }
 
+static inline bool qskIsTransformed( const QQuickItem* item )
+{
+    return ( item->rotation() != 0.0 ) || ( item->scale() != 1.0 )
+        || !QQuickItemPrivate::get( item )->transforms.isEmpty();
+}
+
+static QRectF qskOccupiedRect( const QskSubWindowArea* area, const QskSubWindow* window )
+{
+    // the direct children only, what should be good enough for sub windows
+
+    auto rect = window->boundingRect();
+    if ( !window->clip() )
+        rect = rect.united( window->childrenRect() );
+
+    return window->mapRectToItem( area, rect );
+}
+
+static bool qskIsOpaque( const QskGradient& gradient )
+{
+    if ( !gradient.isValid() )
+        return false;
+
+    for ( const auto& stop : gradient.stops() )
+    {
+        if ( stop.color().alpha() < 255 )
+            return false;
+    }
+
+    return true;
+}
+
+static void qskAddOpaqueRects( const QskSubWindow* window, QVector< QRectF >& rects )
+{
+    using Q = QskSubWindow;
+
+    // a window, that has never been painted, does not cover anything
+    if ( !window->isInitiallyPainted() )
+        return;
+
+    if ( window->opacity() < 1.0 || qskIsTransformed( window ) )
+        return;
+
+    if ( !qskIsOpaque( window->gradientHint( Q::Panel ) ) )
+        return;
+
+    auto rect = window->subControlRect( Q::Panel );
+    if ( rect.isEmpty() )
+        return;
+
+    // the border might be translucent
+
+    const auto border = window->boxBorderMetricsHint( Q::Panel ).toAbsolute( rect.size() );
+    rect = rect.marginsRemoved( border.widths() );
+
+    rect.translate( window->position() );
+
+    const auto shape = window->boxShapeHint( Q::Panel ).toAbsolute( rect.size() );
+
+    if ( shape.isRectangle() )
+    {
+        rects += rect;
+        return;
+    }
+
+    /*
+        The rounded corners are not opaque, but the cross
+        between them is
+     */
+    qreal rx = 0.0;
+    qreal ry = 0.0;
+
+    for ( const auto corner : { Qt::TopLeftCorner, Qt::TopRightCorner,
+        Qt::BottomLeftCorner, Qt::BottomRightCorner } )
+    {
+        const auto radius = shape.radius( corner );
+
+        rx = qMax( rx, radius.width() );
+        ry = qMax( ry, radius.height() );
+    }
+
+    rects += rect.adjusted( rx, 0.0, -rx, 0.0 );
+    rects += rect.adjusted( 0.0, ry, 0.0, -ry );
+}
+
+static inline bool qskIsCovered( const QRectF& rect, const QVector< QRectF >& opaqueRects )
+{
+    for ( const auto& opaqueRect : opaqueRects )
+    {
+        if ( opaqueRect.contains( rect ) )
+            return true;
+    }
+
+    return false;
+}
+
+static void qskResyncItems( QQuickItem* item )
+{
+    /*
+        Dirty items of an occluded sub window have been removed from the
+        dirty list. Now we have to put them back.
+     */
+    auto d = QQuickItemPrivate::get( item );
+
+    if ( d->dirtyAttributes && d->window )
+        d->addToDirtyList();
+
+    for ( auto child : qAsConst( d->childItems ) )
+        qskResyncItems( child );
+}
+
 static Qt::Edges qskSelectedEdges( const QRectF& rect, const QPointF& pos )
 {
     const qreal tolerance = qskDpiScaled( 10.0 );
@@ -91,6 +213,15 @@ class QskSubWindowArea::PrivateData
     bool isDragging : 1;
     Qt::Edges draggedEdges;
     QPointF mousePos;
+
+    // sub windows, that are completely covered by opaque siblings
+    QSet< const QQuickItem* > occludedWindows;
+
+    QPointer< QQuickWindow > window;
+    QMetaObject::Connection syncConnection;
+
+    int skippedItems = 0;
+    quint64 totalSkippedItems = 0;
 };
 
 QskSubWindowArea::QskSubWindowArea( QQuickItem* parent )
@@ -103,6 +234,18 @@ QskSubWindowArea::QskSubWindowArea( QQuickItem* parent )
 
 QskSubWindowArea::~QskSubWindowArea()
 {
+    disconnect( m_data->syncConnection );
+}
+
+QskSubWindowArea::OcclusionStatistics QskSubWindowArea::occlusionStatistics() const
+{
+    OcclusionStatistics statistics;
+
+    statistics.occludedWindows = m_data->occludedWindows.count();
+    statistics.skippedItems = m_data->skippedItems;
+    statistics.totalSkippedItems = m_data->totalSkippedItems;
+
+    return statistics;
 }
 
 void QskSubWindowArea::geometryChangeEvent( QskGeometryChangeEvent* event )
@@ -115,6 +258,93 @@ void QskSubWindowArea::geometryChangeEvent( QskGeometryChangeEvent* event )
     Inherited::geometryChangeEvent( event );
 }
 
+void QskSubWindowArea::windowChangeEvent( QskWindowChangeEvent* event )
+{
+    disconnect( m_data->syncConnection );
+
+    m_data->window = event->window();
+    m_data->skippedItems = 0;
+
+    if ( auto window = event->window() )
+    {
+        /*
+            The scene graph might run in a different thread and we need
+            a direct connection to filter the dirty list before it gets
+            processed. The GUI thread is blocked in the meantime.
+         */
+        m_data->syncConnection = connect( window, &QQuickWindow::beforeSynchronizing,
+            this, &QskSubWindowArea::beforeSynchronizing, Qt::DirectConnection );
+    }
+
+    Inherited::windowChangeEvent( event );
+}
+
+void QskSubWindowArea::updateOcclusion()
+{
+    QSet< const QQuickItem* > occludedWindows;
+    QVector< QRectF > opaqueRects;
+
+    // from top to bottom
+
+    const auto children = QQuickItemPrivate::get( this )->paintOrderChildItems();
+
+    for ( int i = children.count() - 1; i >= 0; i-- )
+    {
+        const auto window = qobject_cast< const QskSubWindow* >( children[ i ] );
+        if ( window == nullptr || !window->isVisible() )
+            continue;
+
+        if ( qskIsCovered( qskOccupiedRect( this, window ), opaqueRects ) )
+            occludedWindows += window;
+        else
+            qskAddOpaqueRects( window, opaqueRects );
+    }
+
+    for ( auto window : qAsConst( m_data->occludedWindows ) )
+    {
+        if ( !occludedWindows.contains( window ) && window->parentItem() == this )
+            qskResyncItems( const_cast< QQuickItem* >( window ) );
+    }
+
+    m_data->occludedWindows = occludedWindows;
+}
+
+void QskSubWindowArea::beforeSynchronizing()
+{
+    /*
+        Called from the scene graph thread, while the GUI thread is blocked.
+
+        The occlusion depends on the geometries, the stacking order and
+        the panels of the sub windows. As panels might be changed by skin
+        hints, states or animators without any notification we
+        recalculate it for each frame. This is cheap compared to
+        synchronizing the items of a sub window.
+     */
+    updateOcclusion();
+
+    int count = 0;
+
+    if ( !m_data->occludedWindows.isEmpty() )
+    {
+        const auto isOccluded =
+            [ this ]( const QQuickItem* item )
+            {
+                for ( ; item != nullptr; item = item->parentItem() )
+                {
+                    if ( item->parentItem() == this )
+                        return m_data->occludedWindows.contains( item );
+                }
+
+                return false;
+            };
+
+        count = QskDirtyItemFilter::filterDirtyList( m_data->window, isOccluded );
+    }
+
+    m_data->skippedItems = count;
+    m_data->totalSkippedItems += count;
+}
+
 void QskSubWindowArea::itemChange(
     QQuickItem::ItemChange change, const QQuickItem::ItemChangeData& value )
 {
@@ -134,8 +364,13 @@ void QskSubWindowArea::itemChange(
         case QQuickItem::ItemChildRemovedChange:
         {
             if ( qobject_cast< QskSubWindow* >( value.item ) )
+            {
                 value.item->removeEventFilter( this );
 
+                m_data->occludedWindows.remove( value.item );
+                qskResyncItems( value.item );
+            }
+
             break;
         }
         default:
@@ -20,11 +20,25 @@ class QSK_EXPORT QskSubWindowArea : public QskControl
   public:
     QSK_SUBCONTROLS( Panel )
 
+    class OcclusionStatistics
+    {
+      public:
+        // sub windows being completely covered by opaque siblings
+        int occludedWindows = 0;
+
+        // items, whose scene graph updates have been skipped in the last frame
+        int skippedItems = 0;
+        quint64 totalSkippedItems = 0;
+    };
+
     QskSubWindowArea( QQuickItem* parent = nullptr );
     ~QskSubWindowArea() override;
 
+    OcclusionStatistics occlusionStatistics() const;
+
   protected:
     void geometryChangeEvent( QskGeometryChangeEvent* ) override;
+    void windowChangeEvent( QskWindowChangeEvent* ) override;
 
     bool eventFilter( QObject*, QEvent* ) override;
     virtual bool mouseEventFilter( QskSubWindow*, const QMouseEvent* );
@@ -35,6 +49,9 @@ class QSK_EXPORT QskSubWindowArea : public QskControl
     virtual void setDragging( QskSubWindow*, bool );
     virtual void setActive( QskSubWindow*, bool );
 
+    void updateOcclusion();
+    void beforeSynchronizing();
+
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
@@ -147,6 +147,61 @@ int QskTabView::insertTab( int index, const QString& tabText, QQuickItem* item )
     return insertTab( index, new QskTabButton( tabText ), item );
 }
 
+int QskTabView::addTab( QskTabButton* button, const QskStackBox::ItemFactory& factory )
+{
+    return insertTab( -1, button, factory );
+}
+
+int QskTabView::insertTab( int index,
+    QskTabButton* button, const QskStackBox::ItemFactory& factory )
+{
+    index = m_data->tabBar->insertTab( index, button );
+    m_data->stackBox->insertItem( index, factory );
+
+    return index;
+}
+
+int QskTabView::addTab( const QString& tabText, const QskStackBox::ItemFactory& factory )
+{
+    return insertTab( -1, tabText, factory );
+}
+
+int QskTabView::insertTab( int index,
+    const QString& tabText, const QskStackBox::ItemFactory& factory )
+{
+    return insertTab( index, new QskTabButton( tabText ), factory );
+}
+
+void QskTabView::setUnloadPolicy( QskStackBox::UnloadPolicy policy )
+{
+    m_data->stackBox->setUnloadPolicy( policy );
+}
+
+QskStackBox::UnloadPolicy QskTabView::unloadPolicy() const
+{
+    return m_data->stackBox->unloadPolicy();
+}
+
+void QskTabView::setUnloadTimeout( int ms )
+{
+    m_data->stackBox->setUnloadTimeout( ms );
+}
+
+int QskTabView::unloadTimeout() const
+{
+    return m_data->stackBox->unloadTimeout();
+}
+
+void QskTabView::setUnloadLimit( int limit )
+{
+    m_data->stackBox->setUnloadLimit( limit );
+}
+
+int QskTabView::unloadLimit() const
+{
+    return m_data->stackBox->unloadLimit();
+}
+
 void QskTabView::removeTab( int index )
 {
     if ( index >= 0 && index < m_data->tabBar->count() )
@@ -156,7 +211,8 @@ void QskTabView::removeTab( int index )
         /*
             We have to remove the item from the stackBox first. Removing
             the tab then will result in a currentIndexChanged, where the stack
-            box will be resynced.
+            box will be resynced. Items created by a factory are deleted
+            by the stack box.
          */
         m_data->stackBox->removeAt( index );
         m_data->tabBar->removeTab( index );
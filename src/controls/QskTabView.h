@@ -8,6 +8,7 @@
 
 #include "QskControl.h"
 #include "QskNamespace.h"
+#include "QskStackBox.h"
 
 class QskTabBar;
 class QskTabButton;
@@ -58,6 +59,23 @@ class QSK_EXPORT QskTabView : public QskControl
     int addTab( const QString&, QQuickItem* );
     int insertTab( int index, const QString&, QQuickItem* );
 
+    // pages, that are created, when being selected for the first time
+    int addTab( QskTabButton*, const QskStackBox::ItemFactory& );
+    int insertTab( int index, QskTabButton*, const QskStackBox::ItemFactory& );
+
+    int addTab( const QString&, const QskStackBox::ItemFactory& );
+    int insertTab( int index, const QString&, const QskStackBox::ItemFactory& );
+
+    // see QskStackBox
+    void setUnloadPolicy( QskStackBox::UnloadPolicy );
+    QskStackBox::UnloadPolicy unloadPolicy() const;
+
+    void setUnloadTimeout( int ms );
+    int unloadTimeout() const;
+
+    void setUnloadLimit( int );
+    int unloadLimit() const;
+
     void removeTab( int index );
     void clear( bool autoDelete = false );
 
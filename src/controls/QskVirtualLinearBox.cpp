@@ -0,0 +1,623 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskVirtualLinearBox.h"
+#include "QskQuick.h"
+
+#include <qhash.h>
+#include <qvector.h>
+
+namespace
+{
+    /*
+        The extents of all indexes organized as Fenwick tree, so that
+        the position of an index, and the index at a position, can be
+        found in O(log n) - also after updating single extents.
+     */
+    class ExtentTable
+    {
+      public:
+        inline int count() const
+        {
+            return m_extents.count();
+        }
+
+        void resize( int count, qreal estimatedExtent )
+        {
+            const int oldCount = m_extents.count();
+
+            m_extents.resize( count );
+            m_measured.resize( count );
+
+            for ( int i = oldCount; i < count; i++ )
+            {
+                m_extents[ i ] = estimatedExtent;
+                m_measured[ i ] = false;
+            }
+
+            rebuild();
+        }
+
+        void reset( qreal estimatedExtent )
+        {
+            m_extents.fill( estimatedExtent );
+            m_measured.fill( false );
+
+            rebuild();
+        }
+
+        void setEstimatedExtent( qreal estimatedExtent )
+        {
+            for ( int i = 0; i < m_extents.count(); i++ )
+            {
+                if ( !m_measured[ i ] )
+                    m_extents[ i ] = estimatedExtent;
+            }
+
+            rebuild();
+        }
+
+        // the extents are kept, but can be replaced by setEstimatedExtent
+        void markEstimated()
+        {
+            m_measured.fill( false );
+        }
+
+        void setSpacing( qreal spacing )
+        {
+            m_spacing = spacing;
+            rebuild();
+        }
+
+        bool setExtent( int index, qreal extent )
+        {
+            m_measured[ index ] = true;
+
+            const qreal delta = extent - m_extents[ index ];
+            if ( delta == 0.0 )
+                return false;
+
+            m_extents[ index ] = extent;
+
+            for ( int i = index + 1; i < m_tree.count(); i += i & -i )
+                m_tree[ i ] += delta;
+
+            return true;
+        }
+
+        inline qreal extent( int index ) const
+        {
+            return m_extents[ index ];
+        }
+
+        // start of the item at index
+        qreal position( int index ) const
+        {
+            qreal pos = 0.0;
+
+            for ( int i = index; i > 0; i -= i & -i )
+                pos += m_tree[ i ];
+
+            return pos;
+        }
+
+        qreal totalExtent() const
+        {
+            const int n = m_extents.count();
+            return ( n > 0 ) ? position( n ) - m_spacing : 0.0;
+        }
+
+        // the item at pos, including the spacing after it
+        int indexAt( qreal pos ) const
+        {
+            int index = 0;
+
+            for ( int step = m_mask; step > 0; step >>= 1 )
+            {
+                const int i = index + step;
+
+                if ( i < m_tree.count() && m_tree[ i ] <= pos )
+                {
+                    index = i;
+                    pos -= m_tree[ i ];
+                }
+            }
+
+            return qMin( index, m_extents.count() - 1 );
+        }
+
+      private:
+        void rebuild()
+        {
+            const int n = m_extents.count();
+
+            m_tree.fill( 0.0, n + 1 );
+
+            for ( int i = 1; i <= n; i++ )
+            {
+                m_tree[ i ] += m_extents[ i - 1 ] + m_spacing;
+
+                const int j = i + ( i & -i );
+                if ( j <= n )
+                    m_tree[ j ] += m_tree[ i ];
+            }
+
+            m_mask = ( n > 0 ) ? 1 : 0;
+            while ( 2 * m_mask <= n )
+                m_mask *= 2;
+        }
+
+        qreal m_spacing = 0.0;
+        int m_mask = 0;
+
+        QVector< qreal > m_extents;
+        QVector< bool > m_measured;
+
+        QVector< qreal > m_tree; // 1 based
+    };
+}
+
+static qreal qskMeasuredExtent( const QQuickItem* item,
+    Qt::Orientation orientation, qreal crossExtent, qreal defaultExtent )
+{
+    QSizeF constraint( -1.0, -1.0 );
+
+    const auto constraintType = qskSizePolicy( item ).constraintType();
+
+    if ( orientation == Qt::Vertical )
+    {
+        if ( constraintType == QskSizePolicy::HeightForWidth )
+            constraint.setWidth( crossExtent );
+    }
+    else
+    {
+        if ( constraintType == QskSizePolicy::WidthForHeight )
+            constraint.setHeight( crossExtent );
+    }
+
+    const auto hint = qskEffectiveSizeHint( item, Qt::PreferredSize, constraint );
+
+    const qreal extent = ( orientation == Qt::Vertical ) ? hint.height() : hint.width();
+    return ( extent >= 0.0 ) ? extent : defaultExtent;
+}
+
+class QskVirtualLinearBox::PrivateData
+{
+  public:
+    PrivateData( Qt::Orientation orientation )
+        : orientation( orientation )
+    {
+    }
+
+    inline qreal along( const QPointF& pos ) const
+    {
+        return ( orientation == Qt::Vertical ) ? pos.y() : pos.x();
+    }
+
+    inline qreal along( const QSizeF& size ) const
+    {
+        return ( orientation == Qt::Vertical ) ? size.height() : size.width();
+    }
+
+    inline qreal across( const QSizeF& size ) const
+    {
+        return ( orientation == Qt::Vertical ) ? size.width() : size.height();
+    }
+
+    void recycleItem( QQuickItem* item )
+    {
+        item->setVisible( false );
+        unusedItems += item;
+    }
+
+    void recycleItems( int from )
+    {
+        for ( auto it = items.begin(); it != items.end(); )
+        {
+            if ( it.key() >= from )
+            {
+                recycleItem( it.value() );
+                it = items.erase( it );
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    QQuickItem* container = nullptr;
+
+    ExtentTable extents;
+
+    QHash< int, QQuickItem* > items;
+    QVector< QQuickItem* > unusedItems;
+
+    qreal spacing = 5.0;
+    qreal estimatedExtent = 40.0;
+    qreal prefetchMargin = 100.0;
+
+    // the cross extent, that has been used for measuring the items
+    qreal measuredCrossExtent = -1.0;
+
+    int scrollIndex = -1;
+
+    Qt::Orientation orientation;
+};
+
+QskVirtualLinearBox::QskVirtualLinearBox( QQuickItem* parent )
+    : QskVirtualLinearBox( Qt::Vertical, parent )
+{
+}
+
+QskVirtualLinearBox::QskVirtualLinearBox(
+        Qt::Orientation orientation, QQuickItem* parent )
+    : Inherited( parent )
+    , m_data( new PrivateData( orientation ) )
+{
+    m_data->extents.setSpacing( m_data->spacing );
+
+    // the size of the scrolled item is adjusted by us
+    setItemResizable( false );
+
+    auto container = new QQuickItem();
+    container->setObjectName( QStringLiteral( "QskVirtualLinearBoxContents" ) );
+
+    setScrolledItem( container );
+    m_data->container = container;
+
+    if ( orientation == Qt::Vertical )
+        setHorizontalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
+    else
+        setVerticalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
+
+    setFlickableOrientations( orientation );
+
+    connect( this, &QskScrollBox::scrollPosChanged, this, &QQuickItem::polish );
+}
+
+QskVirtualLinearBox::~QskVirtualLinearBox()
+{
+}
+
+void QskVirtualLinearBox::setOrientation( Qt::Orientation orientation )
+{
+    if ( orientation == m_data->orientation )
+        return;
+
+    m_data->orientation = orientation;
+
+    // all extents have been measured for the other orientation
+    m_data->recycleItems( 0 );
+    m_data->extents.reset( m_data->estimatedExtent );
+
+    if ( orientation == Qt::Vertical )
+    {
+        setHorizontalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
+        setVerticalScrollBarPolicy( Qt::ScrollBarAsNeeded );
+    }
+    else
+    {
+        setHorizontalScrollBarPolicy( Qt::ScrollBarAsNeeded );
+        setVerticalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
+    }
+
+    setFlickableOrientations( orientation );
+    setScrollPos( QPointF() );
+
+    polish();
+    Q_EMIT orientationChanged( orientation );
+}
+
+Qt::Orientation QskVirtualLinearBox::orientation() const
+{
+    return m_data->orientation;
+}
+
+void QskVirtualLinearBox::setItemCount( int count )
+{
+    count = qMax( count, 0 );
+
+    if ( count == m_data->extents.count() )
+        return;
+
+    m_data->recycleItems( count );
+    m_data->extents.resize( count, m_data->estimatedExtent );
+
+    polish();
+    Q_EMIT itemCountChanged( count );
+}
+
+int QskVirtualLinearBox::itemCount() const
+{
+    return m_data->extents.count();
+}
+
+void QskVirtualLinearBox::setSpacing( qreal spacing )
+{
+    spacing = qMax( spacing, 0.0 );
+
+    if ( spacing == m_data->spacing )
+        return;
+
+    m_data->spacing = spacing;
+    m_data->extents.setSpacing( spacing );
+
+    polish();
+    Q_EMIT spacingChanged( spacing );
+}
+
+qreal QskVirtualLinearBox::spacing() const
+{
+    return m_data->spacing;
+}
+
+void QskVirtualLinearBox::setEstimatedItemExtent( qreal extent )
+{
+    extent = qMax( extent, 0.0 );
+
+    if ( extent == m_data->estimatedExtent )
+        return;
+
+    m_data->estimatedExtent = extent;
+    m_data->extents.setEstimatedExtent( extent );
+
+    polish();
+    Q_EMIT estimatedItemExtentChanged( extent );
+}
+
+qreal QskVirtualLinearBox::estimatedItemExtent() const
+{
+    return m_data->estimatedExtent;
+}
+
+void QskVirtualLinearBox::setPrefetchMargin( qreal margin )
+{
+    margin = qMax( margin, 0.0 );
+
+    if ( margin == m_data->prefetchMargin )
+        return;
+
+    m_data->prefetchMargin = margin;
+
+    polish();
+    Q_EMIT prefetchMarginChanged( margin );
+}
+
+qreal QskVirtualLinearBox::prefetchMargin() const
+{
+    return m_data->prefetchMargin;
+}
+
+QQuickItem* QskVirtualLinearBox::itemAt( int index ) const
+{
+    return m_data->items.value( index, nullptr );
+}
+
+int QskVirtualLinearBox::indexAt( qreal pos ) const
+{
+    const auto& extents = m_data->extents;
+
+    if ( extents.count() == 0 || pos < 0.0 || pos > extents.totalExtent() )
+        return -1;
+
+    return extents.indexAt( pos );
+}
+
+qreal QskVirtualLinearBox::itemPosition( int index ) const
+{
+    if ( index < 0 || index >= m_data->extents.count() )
+        return -1.0;
+
+    return m_data->extents.position( index );
+}
+
+int QskVirtualLinearBox::instantiatedCount() const
+{
+    return m_data->items.count();
+}
+
+void QskVirtualLinearBox::scrollToIndex( int index )
+{
+    if ( index >= 0 && index < m_data->extents.count() )
+    {
+        // done in updateLayout, when the scrollable size is known
+        m_data->scrollIndex = index;
+        polish();
+    }
+}
+
+void QskVirtualLinearBox::updateItems()
+{
+    const auto crossExtent = m_data->across( m_data->container->size() );
+
+    for ( auto it = m_data->items.constBegin(); it != m_data->items.constEnd(); ++it )
+    {
+        updateItem( it.value(), it.key() );
+
+        const auto extent = qskMeasuredExtent( it.value(),
+            m_data->orientation, crossExtent, m_data->estimatedExtent );
+
+        m_data->extents.setExtent( it.key(), extent );
+    }
+
+    polish();
+}
+
+void QskVirtualLinearBox::updateLayout()
+{
+    adjustContentsSize();
+    Inherited::updateLayout();
+
+    {
+        // the viewport shrinks, when the scroll bar appears
+
+        const auto size = m_data->container->size();
+        adjustContentsSize();
+
+        if ( m_data->container->size() != size )
+            Inherited::updateLayout();
+    }
+
+    if ( m_data->scrollIndex >= 0 )
+    {
+        const auto pos = m_data->extents.position( m_data->scrollIndex );
+        m_data->scrollIndex = -1;
+
+        if ( m_data->orientation == Qt::Vertical )
+            setScrollPos( QPointF( scrollPos().x(), pos ) );
+        else
+            setScrollPos( QPointF( pos, scrollPos().y() ) );
+    }
+
+    layoutItems();
+}
+
+void QskVirtualLinearBox::layoutItems()
+{
+    auto& extents = m_data->extents;
+    auto& items = m_data->items;
+
+    const auto orientation = m_data->orientation;
+    const auto crossExtent = m_data->across( m_data->container->size() );
+
+    const qreal scrollPos = m_data->along( this->scrollPos() );
+    const qreal viewExtent = m_data->along( viewContentsRect().size() );
+
+    bool remeasure = false;
+
+    if ( crossExtent != m_data->measuredCrossExtent )
+    {
+        /*
+            The extents of heightForWidth/widthForHeight items depend on
+            the cross extent. Instantiated items are measured again below,
+            all others will be measured, when being bound.
+         */
+        m_data->measuredCrossExtent = crossExtent;
+
+        extents.markEstimated();
+        remeasure = true;
+    }
+
+    const qreal from = qMax( scrollPos - m_data->prefetchMargin, 0.0 );
+    const qreal to = scrollPos + viewExtent + m_data->prefetchMargin;
+
+    int first = 0;
+    int last = -1;
+
+    if ( extents.count() > 0 && viewExtent > 0.0 )
+    {
+        first = extents.indexAt( from );
+        last = extents.indexAt( to );
+    }
+
+    for ( auto it = items.begin(); it != items.end(); )
+    {
+        if ( it.key() < first || it.key() > last )
+        {
+            m_data->recycleItem( it.value() );
+            it = items.erase( it );
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    /*
+        Measuring the new items shifts the following ones. Items above
+        the viewport would shift the visible ones, what is compensated
+        by adjusting the scroll position.
+     */
+    const int topIndex = ( last >= first ) ? extents.indexAt( scrollPos ) : 0;
+    qreal scrollDelta = 0.0;
+
+    for ( int index = first; index <= last; index++ )
+    {
+        auto item = items.value( index, nullptr );
+
+        if ( item )
+        {
+            if ( !remeasure )
+                continue;
+        }
+        else
+        {
+            if ( !m_data->unusedItems.isEmpty() )
+            {
+                item = m_data->unusedItems.takeLast();
+            }
+            else
+            {
+                item = createItem();
+                if ( item == nullptr )
+                    continue;
+
+                item->setParentItem( m_data->container );
+                if ( item->parent() == nullptr )
+                    item->setParent( m_data->container );
+            }
+
+            updateItem( item, index );
+            item->setVisible( true );
+
+            items.insert( index, item );
+        }
+
+        const auto oldExtent = extents.extent( index );
+        const auto extent = qskMeasuredExtent( item,
+            orientation, crossExtent, m_data->estimatedExtent );
+
+        if ( extents.setExtent( index, extent ) )
+        {
+            if ( index < topIndex )
+                scrollDelta += extent - oldExtent;
+            else
+                last = qMax( extents.indexAt( to ), index );
+        }
+    }
+
+    for ( auto it = items.constBegin(); it != items.constEnd(); ++it )
+    {
+        const auto pos = extents.position( it.key() );
+        const auto extent = extents.extent( it.key() );
+
+        QRectF rect;
+        if ( orientation == Qt::Vertical )
+            rect.setRect( 0.0, pos, crossExtent, extent );
+        else
+            rect.setRect( pos, 0.0, extent, crossExtent );
+
+        qskSetItemGeometry( it.value(), rect );
+    }
+
+    adjustContentsSize();
+
+    if ( scrollDelta != 0.0 )
+    {
+        setScrollableSize( m_data->container->size() );
+
+        if ( orientation == Qt::Vertical )
+            setScrollPos( this->scrollPos() + QPointF( 0.0, scrollDelta ) );
+        else
+            setScrollPos( this->scrollPos() + QPointF( scrollDelta, 0.0 ) );
+    }
+}
+
+void QskVirtualLinearBox::adjustContentsSize()
+{
+    const auto viewSize = viewContentsRect().size();
+    const auto totalExtent = m_data->extents.totalExtent();
+
+    QSizeF size;
+    if ( m_data->orientation == Qt::Vertical )
+        size = QSizeF( viewSize.width(), totalExtent );
+    else
+        size = QSizeF( totalExtent, viewSize.height() );
+
+    m_data->container->setSize( size );
+}
+
+#include "moc_QskVirtualLinearBox.cpp"
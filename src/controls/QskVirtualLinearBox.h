@@ -0,0 +1,106 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_VIRTUAL_LINEAR_BOX_H
+#define QSK_VIRTUAL_LINEAR_BOX_H
+
+#include "QskScrollArea.h"
+
+/*
+    A scroll area, that arranges a row or column of itemCount() items,
+    but instantiates only those intersecting the viewport plus a prefetch
+    margin. Items leaving this range are recycled for other indexes.
+
+    Items are created by createItem() and bound to an index by updateItem().
+    Indexes, that have not been instantiated so far, are assumed to have
+    the estimatedItemExtent(). Once an item has been bound, its preferred
+    size is used instead. When the cross extent changes - f.e. for items
+    with a heightForWidth dependency - the instantiated items are measured
+    again, while the extents of all others are considered as estimates.
+
+    The scrolled item is owned by the box and must not be replaced.
+ */
+class QSK_EXPORT QskVirtualLinearBox : public QskScrollArea
+{
+    Q_OBJECT
+
+    Q_PROPERTY( Qt::Orientation orientation READ orientation
+        WRITE setOrientation NOTIFY orientationChanged FINAL )
+
+    Q_PROPERTY( int itemCount READ itemCount
+        WRITE setItemCount NOTIFY itemCountChanged FINAL )
+
+    Q_PROPERTY( qreal spacing READ spacing
+        WRITE setSpacing NOTIFY spacingChanged FINAL )
+
+    Q_PROPERTY( qreal estimatedItemExtent READ estimatedItemExtent
+        WRITE setEstimatedItemExtent NOTIFY estimatedItemExtentChanged FINAL )
+
+    Q_PROPERTY( qreal prefetchMargin READ prefetchMargin
+        WRITE setPrefetchMargin NOTIFY prefetchMarginChanged FINAL )
+
+    using Inherited = QskScrollArea;
+
+  public:
+    QskVirtualLinearBox( QQuickItem* parent = nullptr );
+    QskVirtualLinearBox( Qt::Orientation, QQuickItem* parent = nullptr );
+
+    ~QskVirtualLinearBox() override;
+
+    void setOrientation( Qt::Orientation );
+    Qt::Orientation orientation() const;
+
+    void setItemCount( int );
+    int itemCount() const;
+
+    void setSpacing( qreal );
+    qreal spacing() const;
+
+    void setEstimatedItemExtent( qreal );
+    qreal estimatedItemExtent() const;
+
+    void setPrefetchMargin( qreal );
+    qreal prefetchMargin() const;
+
+    // nullptr, when the index is not instantiated
+    QQuickItem* itemAt( int index ) const;
+
+    // index of the item at a position of the scrolled item
+    int indexAt( qreal pos ) const;
+
+    // position of an item inside of the scrolled item
+    qreal itemPosition( int index ) const;
+
+    // the number of items, that are bound to an index
+    int instantiatedCount() const;
+
+  Q_SIGNALS:
+    void orientationChanged( Qt::Orientation );
+    void itemCountChanged( int );
+    void spacingChanged( qreal );
+    void estimatedItemExtentChanged( qreal );
+    void prefetchMarginChanged( qreal );
+
+  public Q_SLOTS:
+    void scrollToIndex( int index );
+
+    // rebinding the instantiated items, after the data has changed
+    void updateItems();
+
+  protected:
+    virtual QQuickItem* createItem() = 0;
+    virtual void updateItem( QQuickItem*, int index ) = 0;
+
+    void updateLayout() override;
+
+  private:
+    void layoutItems();
+    void adjustContentsSize();
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
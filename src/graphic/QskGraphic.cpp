@@ -22,6 +22,19 @@ QSK_QT_PRIVATE_BEGIN
 #include <private/qpaintengineex_p.h>
 QSK_QT_PRIVATE_END
 
+static inline void qskPreparePath( const QPainterPath& path )
+{
+    /*
+        QPainterPath and its QVectorPath representation calculate some
+        values lazily and store them in the shared data. Calculating them
+        in advance allows to render a const graphic from several threads
+        at the same time.
+     */
+    ( void ) path.boundingRect();
+    ( void ) path.controlPointRect();
+    ( void ) qtVectorPathForPath( path ).controlPointRect();
+}
+
 static inline qreal qskDevicePixelRatio()
 {
     return qGuiApp ? qGuiApp->devicePixelRatio() : 1.0;
@@ -667,6 +680,40 @@ void QskGraphic::render( QPainter* painter, const QRectF& rect,
     if ( isEmpty() || rect.isEmpty() )
         return;
 
+    const bool scalePens = !( m_data->renderHints & RenderPensUnscaled );
+    const auto tr = transformation( rect, aspectRatioMode );
+
+    const auto transform = painter->transform();
+
+    painter->setTransform( tr, true );
+
+    if ( !scalePens && transform.isScaling() )
+    {
+        /*
+            We don't want to scale pens according to sx/sy,
+            but we want to apply the initial scaling from the
+            painter transformation.
+         */
+
+        QTransform initialTransform;
+        initialTransform.scale( transform.m11(), transform.m22() );
+
+        render( painter, colorFilter, &initialTransform );
+    }
+    else
+    {
+        render( painter, colorFilter, nullptr );
+    }
+
+    painter->setTransform( transform );
+}
+
+QTransform QskGraphic::transformation(
+    const QRectF& rect, Qt::AspectRatioMode aspectRatioMode ) const
+{
+    if ( isEmpty() || rect.isEmpty() )
+        return QTransform();
+
     qreal sx = 1.0;
     qreal sy = 1.0;
 
@@ -712,29 +759,7 @@ void QskGraphic::render( QPainter* painter, const QRectF& rect,
     tr.scale( sx, sy );
     tr.translate( -pr.x(), -pr.y() );
 
-    const auto transform = painter->transform();
-
-    painter->setTransform( tr, true );
-
-    if ( !scalePens && transform.isScaling() )
-    {
-        /*
-            We don't want to scale pens according to sx/sy,
-            but we want to apply the initial scaling from the
-            painter transformation.
-         */
-
-        QTransform initialTransform;
-        initialTransform.scale( transform.m11(), transform.m22() );
-
-        render( painter, colorFilter, &initialTransform );
-    }
-    else
-    {
-        render( painter, colorFilter, nullptr );
-    }
-
-    painter->setTransform( transform );
+    return tr;
 }
 
 void QskGraphic::render( QPainter* painter,
@@ -867,6 +892,8 @@ void QskGraphic::drawPath( const QPainterPath& path )
     if ( painter == nullptr )
         return;
 
+    qskPreparePath( path );
+
     m_data->addCommand( QskPainterCommand( path ) );
     m_data->commandTypes |= QskGraphic::VectorData;
 
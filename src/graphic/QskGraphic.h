@@ -70,6 +70,11 @@ class QSK_EXPORT QskGraphic : public QPaintDevice
 
     CommandTypes commandTypes() const;
 
+    /*
+        Rendering is reentrant: the same graphic can be rendered from
+        different threads at the same time - as long as it is not modified
+        and contains no pixmaps.
+     */
     void render( QPainter* ) const;
     void render( QPainter*, const QskColorFilter&,
         QTransform* initialTransform = nullptr ) const;
@@ -86,6 +91,10 @@ class QSK_EXPORT QskGraphic : public QPaintDevice
     void render( QPainter*, const QRectF&, const QskColorFilter&,
         Qt::AspectRatioMode = Qt::IgnoreAspectRatio ) const;
 
+    // mapping from the coordinates of the commands into rect
+    QTransform transformation( const QRectF&,
+        Qt::AspectRatioMode = Qt::IgnoreAspectRatio ) const;
+
     QPixmap toPixmap( qreal devicePixelRatio = 0.0 ) const;
 
     QPixmap toPixmap( const QSize&,
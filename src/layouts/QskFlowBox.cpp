@@ -0,0 +1,415 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskFlowBox.h"
+#include "QskFlowLayoutEngine.h"
+#include "QskEvent.h"
+#include "QskQuick.h"
+
+static void qskSetItemActive( QObject* receiver, const QQuickItem* item, bool on )
+{
+    /*
+        For QQuickItems not being derived from QskControl we manually
+        send QEvent::LayoutRequest events.
+     */
+
+    if ( on )
+    {
+        auto sendLayoutRequest =
+            [receiver]()
+            {
+                QEvent event( QEvent::LayoutRequest );
+                QCoreApplication::sendEvent( receiver, &event );
+            };
+
+        QObject::connect( item, &QQuickItem::implicitWidthChanged,
+            receiver, sendLayoutRequest );
+
+        QObject::connect( item, &QQuickItem::implicitHeightChanged,
+            receiver, sendLayoutRequest );
+    }
+    else
+    {
+        QObject::disconnect( item, &QQuickItem::implicitWidthChanged, receiver, nullptr );
+        QObject::disconnect( item, &QQuickItem::implicitHeightChanged, receiver, nullptr );
+    }
+}
+
+static inline QskSizePolicy qskFlowSizePolicy( Qt::Orientation orientation )
+{
+    // the size of the lines depends on how many items fit into them
+
+    if ( orientation == Qt::Horizontal )
+        return QskSizePolicy( QskSizePolicy::Preferred, QskSizePolicy::Constrained );
+    else
+        return QskSizePolicy( QskSizePolicy::Constrained, QskSizePolicy::Preferred );
+}
+
+class QskFlowBox::PrivateData
+{
+  public:
+    PrivateData( Qt::Orientation orientation )
+        : engine( orientation )
+    {
+    }
+
+    QskFlowLayoutEngine engine;
+};
+
+QskFlowBox::QskFlowBox( QQuickItem* parent )
+    : QskFlowBox( Qt::Horizontal, parent )
+{
+}
+
+QskFlowBox::QskFlowBox( Qt::Orientation orientation, QQuickItem* parent )
+    : QskIndexedLayoutBox( parent )
+    , m_data( new PrivateData( orientation ) )
+{
+    const auto policy = qskFlowSizePolicy( orientation );
+    initSizePolicy( policy.horizontalPolicy(), policy.verticalPolicy() );
+
+    m_data->engine.setSpacing(
+        spacingHint( Panel ), Qt::Horizontal | Qt::Vertical );
+}
+
+QskFlowBox::~QskFlowBox()
+{
+    auto& engine = m_data->engine;
+
+    for ( int i = 0; i < engine.count(); i++ )
+    {
+        if ( auto item = engine.itemAt( i ) )
+        {
+            // see ~QskLinearBox
+            setItemActive( item, false );
+        }
+    }
+}
+
+int QskFlowBox::elementCount() const
+{
+    return m_data->engine.count();
+}
+
+QQuickItem* QskFlowBox::itemAtIndex( int index ) const
+{
+    return m_data->engine.itemAt( index );
+}
+
+int QskFlowBox::indexOf( const QQuickItem* item ) const
+{
+    return m_data->engine.indexOf( item );
+}
+
+void QskFlowBox::removeAt( int index )
+{
+    removeItemInternal( index, true );
+}
+
+void QskFlowBox::removeItemInternal( int index, bool unparent )
+{
+    auto& engine = m_data->engine;
+
+    if ( index < 0 || index >= engine.count() )
+        return;
+
+    auto item = engine.itemAt( index );
+    engine.removeAt( index );
+
+    if ( item )
+    {
+        setItemActive( item, false );
+
+        if ( unparent )
+            unparentItem( item );
+    }
+
+    resetImplicitSize();
+    polish();
+}
+
+void QskFlowBox::removeItem( const QQuickItem* item )
+{
+    removeAt( indexOf( item ) );
+}
+
+void QskFlowBox::clear( bool autoDelete )
+{
+    auto& engine = m_data->engine;
+
+    const bool hasElements = engine.count() > 0;
+
+    for ( int i = engine.count() - 1; i >= 0; i-- )
+    {
+        auto item = engine.itemAt( i );
+        engine.removeAt( i );
+
+        if( item )
+        {
+            setItemActive( item, false );
+
+            if( autoDelete && ( item->parent() == this ) )
+                delete item;
+            else
+                unparentItem( item );
+        }
+    }
+
+    if ( hasElements )
+        resetImplicitSize();
+}
+
+void QskFlowBox::autoAddItem( QQuickItem* item )
+{
+    insertItem( -1, item );
+}
+
+void QskFlowBox::autoRemoveItem( QQuickItem* item )
+{
+    removeItemInternal( indexOf( item ), false );
+}
+
+void QskFlowBox::activate()
+{
+    polish();
+}
+
+void QskFlowBox::invalidate()
+{
+    m_data->engine.invalidate();
+
+    resetImplicitSize();
+    polish();
+}
+
+void QskFlowBox::setItemActive( QQuickItem* item, bool on )
+{
+    if ( on )
+    {
+        QObject::connect( item, &QQuickItem::visibleChanged,
+            this, &QskFlowBox::invalidate );
+    }
+    else
+    {
+        QObject::disconnect( item, &QQuickItem::visibleChanged,
+            this, &QskFlowBox::invalidate );
+    }
+
+    if ( qskControlCast( item ) == nullptr )
+        qskSetItemActive( this, item, on );
+}
+
+int QskFlowBox::lineCount() const
+{
+    return m_data->engine.lineCount();
+}
+
+void QskFlowBox::updateLayout()
+{
+    if ( !maybeUnresized() )
+        m_data->engine.setGeometries( layoutRect() );
+}
+
+QSizeF QskFlowBox::layoutSizeHint(
+    Qt::SizeHint which, const QSizeF& constraint ) const
+{
+    if ( which == Qt::MaximumSize )
+    {
+        // we can extend beyond the maximum size of the children
+        return QSizeF();
+    }
+
+    return m_data->engine.sizeHint( which, constraint );
+}
+
+void QskFlowBox::geometryChangeEvent( QskGeometryChangeEvent* event )
+{
+    Inherited::geometryChangeEvent( event );
+
+    if ( event->isResized() )
+        polish();
+}
+
+void QskFlowBox::itemChange( ItemChange change, const ItemChangeData& value )
+{
+    Inherited::itemChange( change, value );
+
+    if ( change == QQuickItem::ItemVisibleHasChanged )
+    {
+        // when becoming visible we should run into polish anyway
+        if ( value.boolValue )
+            polish();
+    }
+}
+
+bool QskFlowBox::event( QEvent* event )
+{
+    switch ( static_cast< int >( event->type() ) )
+    {
+        case QEvent::LayoutRequest:
+        {
+            invalidate();
+            break;
+        }
+        case QEvent::LayoutDirectionChange:
+        {
+            m_data->engine.setVisualDirection(
+                layoutMirroring() ? Qt::RightToLeft : Qt::LeftToRight );
+
+            polish();
+            break;
+        }
+        case QEvent::ContentsRectChange:
+        {
+            polish();
+            break;
+        }
+    }
+
+    return Inherited::event( event );
+}
+
+void QskFlowBox::setOrientation( Qt::Orientation orientation )
+{
+    if ( m_data->engine.setOrientation( orientation ) )
+    {
+        setSizePolicy( qskFlowSizePolicy( orientation ) );
+
+        polish();
+        resetImplicitSize();
+
+        Q_EMIT orientationChanged();
+    }
+}
+
+Qt::Orientation QskFlowBox::orientation() const
+{
+    return m_data->engine.orientation();
+}
+
+void QskFlowBox::transpose()
+{
+    if ( orientation() == Qt::Horizontal )
+        setOrientation( Qt::Vertical );
+    else
+        setOrientation( Qt::Horizontal );
+}
+
+void QskFlowBox::setDefaultAlignment( Qt::Alignment alignment )
+{
+    if ( m_data->engine.setDefaultAlignment( alignment ) )
+    {
+        polish();
+        Q_EMIT defaultAlignmentChanged();
+    }
+}
+
+Qt::Alignment QskFlowBox::defaultAlignment() const
+{
+    return m_data->engine.defaultAlignment();
+}
+
+void QskFlowBox::setSpacing( qreal spacing )
+{
+    if ( m_data->engine.setSpacing(
+        spacing, Qt::Horizontal | Qt::Vertical ) )
+    {
+        resetImplicitSize();
+        polish();
+
+        Q_EMIT spacingChanged();
+    }
+}
+
+void QskFlowBox::resetSpacing()
+{
+    setSpacing( spacingHint( Panel ) );
+}
+
+qreal QskFlowBox::spacing() const
+{
+    return m_data->engine.spacing( Qt::Horizontal );
+}
+
+int QskFlowBox::addItem( QQuickItem* item, Qt::Alignment alignment )
+{
+    return insertItem( -1, item, alignment );
+}
+
+int QskFlowBox::addItem( QQuickItem* item )
+{
+    return insertItem( -1, item );
+}
+
+int QskFlowBox::insertItem(
+    int index, QQuickItem* item, Qt::Alignment alignment )
+{
+    if ( auto control = qskControlCast( item ) )
+        control->setLayoutAlignmentHint( alignment );
+
+    return insertItem( index, item );
+}
+
+int QskFlowBox::insertItem( int index, QQuickItem* item )
+{
+    if ( item == nullptr || item == this )
+        return -1;
+
+    if ( !qskPlacementPolicy( item ).isEffective() )
+    {
+        qWarning() << "Inserting an item that is to be ignored for layouting:"
+            << item->metaObject()->className();
+
+        qskSetPlacementPolicy( item, QskPlacementPolicy() );
+    }
+
+    auto& engine = m_data->engine;
+
+    if ( item->parentItem() == this )
+    {
+        const int oldIndex = indexOf( item );
+        if ( oldIndex >= 0 )
+        {
+            // the item has been inserted before
+
+            const bool doAppend = index < 0 || index >= engine.count();
+
+            if ( ( index == oldIndex ) ||
+                ( doAppend && oldIndex == engine.count() - 1 ) )
+            {
+                // already at its position, nothing to do
+                return oldIndex;
+            }
+
+            removeAt( oldIndex );
+        }
+    }
+
+    reparentItem( item );
+
+    index = engine.insertItem( item, index );
+
+    // Re-ordering the child items to have a a proper focus tab chain
+
+    if ( index < engine.count() - 1 )
+    {
+        item->stackBefore( engine.itemAt( index + 1 ) );
+    }
+    else
+    {
+        const auto children = childItems();
+        if ( item != children.last() )
+            item->stackAfter( children.last() );
+    }
+
+    setItemActive( item, true );
+
+    resetImplicitSize();
+    polish();
+
+    return index;
+}
+
+#include "moc_QskFlowBox.cpp"
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_FLOW_BOX_H
+#define QSK_FLOW_BOX_H
+
+#include "QskIndexedLayoutBox.h"
+
+/*
+    Items are arranged in lines of their preferred sizes. A line is wrapped
+    as soon as the next item does not fit - f.e for a list of tags.
+
+    For Qt::Horizontal the height depends on the width, for
+    Qt::Vertical the width depends on the height.
+ */
+class QSK_EXPORT QskFlowBox : public QskIndexedLayoutBox
+{
+    Q_OBJECT
+
+    Q_PROPERTY( Qt::Orientation orientation READ orientation
+        WRITE setOrientation NOTIFY orientationChanged FINAL )
+
+    Q_PROPERTY( qreal spacing READ spacing
+        WRITE setSpacing RESET resetSpacing NOTIFY spacingChanged FINAL )
+
+    Q_PROPERTY( Qt::Alignment defaultAlignment READ defaultAlignment
+        WRITE setDefaultAlignment NOTIFY defaultAlignmentChanged )
+
+    Q_PROPERTY( int elementCount READ elementCount )
+    Q_PROPERTY( bool empty READ isEmpty() )
+
+    using Inherited = QskIndexedLayoutBox;
+
+  public:
+    explicit QskFlowBox( QQuickItem* parent = nullptr );
+    explicit QskFlowBox( Qt::Orientation, QQuickItem* parent = nullptr );
+
+    ~QskFlowBox() override;
+
+    bool isEmpty() const;
+    int elementCount() const;
+
+    QQuickItem* itemAtIndex( int index ) const;
+    int indexOf( const QQuickItem* ) const;
+
+    void removeItem( const QQuickItem* );
+    void removeAt( int index );
+
+    Qt::Orientation orientation() const;
+    void setOrientation( Qt::Orientation );
+
+    void setDefaultAlignment( Qt::Alignment );
+    Qt::Alignment defaultAlignment() const;
+
+    void setSpacing( qreal spacing );
+    void resetSpacing();
+    qreal spacing() const;
+
+    // the number of rows/columns for the current geometry
+    int lineCount() const;
+
+    Q_INVOKABLE int addItem( QQuickItem* );
+    int addItem( QQuickItem*, Qt::Alignment );
+
+    Q_INVOKABLE int insertItem( int index, QQuickItem* );
+    int insertItem( int index, QQuickItem*, Qt::Alignment );
+
+  public Q_SLOTS:
+    void transpose();
+    void activate();
+    void invalidate();
+    void clear( bool autoDelete = false );
+
+  Q_SIGNALS:
+    void orientationChanged();
+    void defaultAlignmentChanged();
+    void spacingChanged();
+
+  protected:
+    bool event( QEvent* ) override;
+    void geometryChangeEvent( QskGeometryChangeEvent* ) override;
+
+    void itemChange( ItemChange, const ItemChangeData& ) override;
+    void updateLayout() override;
+
+    QSizeF layoutSizeHint( Qt::SizeHint, const QSizeF& ) const override;
+
+  private:
+    void autoAddItem( QQuickItem* ) override final;
+    void autoRemoveItem( QQuickItem* ) override final;
+
+    void setItemActive( QQuickItem*, bool );
+    void removeItemInternal( int index, bool unparent );
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+inline bool QskFlowBox::isEmpty() const
+{
+    return elementCount() <= 0;
+}
+
+#endif
@@ -0,0 +1,663 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskFlowLayoutEngine.h"
+#include "QskQuick.h"
+
+#include <qguiapplication.h>
+#include <qvector.h>
+
+#include <algorithm>
+#include <limits>
+
+static const int qskNoDirtyElement = std::numeric_limits< int >::max();
+
+static QskFlowLayoutEngine::Statistics qskStatistics;
+
+namespace
+{
+    class Element
+    {
+      public:
+        QQuickItem* item = nullptr;
+
+        QSizeF hint; // the preferred size
+        quint64 serial = 0;
+
+        bool isIgnored = false;
+        bool isValid = false;
+    };
+
+    class Line
+    {
+      public:
+        int first = 0; // index of the first element
+        int end = 0;   // index behind the last element
+
+        int itemCount = 0; // not counting ignored elements
+
+        qreal position = 0.0;  // offset of the line
+        qreal extent = 0.0;    // including the spacings between the items
+        qreal thickness = 0.0;
+
+        // extent of the first item, needed to decide if it fits into the previous line
+        qreal firstExtent = 0.0;
+    };
+}
+
+class QskFlowLayoutEngine::PrivateData
+{
+  public:
+    PrivateData( Qt::Orientation orientation )
+        : orientation( orientation )
+    {
+    }
+
+    inline qreal along( const QSizeF& size ) const
+    {
+        return ( orientation == Qt::Horizontal ) ? size.width() : size.height();
+    }
+
+    inline qreal across( const QSizeF& size ) const
+    {
+        return ( orientation == Qt::Horizontal ) ? size.height() : size.width();
+    }
+
+    inline QSizeF size( qreal along, qreal across ) const
+    {
+        return ( orientation == Qt::Horizontal )
+            ? QSizeF( along, across ) : QSizeF( across, along );
+    }
+
+    inline qreal spacing( bool isAlong ) const
+    {
+        return ( ( orientation == Qt::Horizontal ) == isAlong )
+            ? horizontalSpacing : verticalSpacing;
+    }
+
+    inline Qt::Alignment effectiveAlignment( Qt::Alignment alignment ) const
+    {
+        if ( !( alignment & Qt::AlignVertical_Mask ) )
+            alignment |= ( defaultAlignment & Qt::AlignVertical_Mask );
+
+        if ( !( alignment & Qt::AlignHorizontal_Mask ) )
+            alignment |= ( defaultAlignment & Qt::AlignHorizontal_Mask );
+
+        return alignment;
+    }
+
+    inline void setDirty( int index )
+    {
+        firstDirty = qMin( firstDirty, index );
+    }
+
+    void resetLines()
+    {
+        lines.clear();
+        lineExtent = -1.0;
+        laidOutLines = 0;
+        firstDirty = 0;
+    }
+
+    int lineOf( int index ) const
+    {
+        auto it = std::upper_bound( lines.constBegin(), lines.constEnd(), index,
+            []( int i, const Line& line ) { return i < line.first; } );
+
+        return qMax( int( it - lines.constBegin() ) - 1, 0 );
+    }
+
+    qreal thickness( qreal extent ) const
+    {
+        // total thickness of the lines, without touching the cached line breaks
+
+        const auto spacingAlong = spacing( true );
+        const auto spacingAcross = spacing( false );
+
+        qreal total = 0.0;
+
+        qreal lineExtent = 0.0;
+        qreal lineThickness = 0.0;
+        int itemCount = 0;
+
+        for ( const auto& element : elements )
+        {
+            if ( element.isIgnored )
+                continue;
+
+            const auto hintAlong = along( element.hint );
+
+            if ( itemCount > 0 && lineExtent + spacingAlong + hintAlong > extent )
+            {
+                total += lineThickness + spacingAcross;
+
+                lineExtent = lineThickness = 0.0;
+                itemCount = 0;
+            }
+
+            lineExtent += ( itemCount > 0 ) ? spacingAlong + hintAlong : hintAlong;
+            lineThickness = qMax( lineThickness, across( element.hint ) );
+
+            itemCount++;
+        }
+
+        return total + lineThickness;
+    }
+
+    QVector< Element > elements;
+
+    QVector< Line > lines;
+    qreal lineExtent = -1.0; // the extent, the lines have been calculated for
+
+    int firstDirty = 0;
+    bool checkHints = true;
+
+    // the lines, that have been laid out for layoutRect
+    QRectF layoutRect;
+    int laidOutLines = 0;
+
+    qreal horizontalSpacing = 0.0;
+    qreal verticalSpacing = 0.0;
+
+    Qt::Alignment defaultAlignment = Qt::AlignLeft | Qt::AlignVCenter;
+    Qt::LayoutDirection visualDirection = Qt::LeftToRight;
+    Qt::Orientation orientation;
+};
+
+QskFlowLayoutEngine::QskFlowLayoutEngine( Qt::Orientation orientation )
+    : m_data( new PrivateData( orientation ) )
+{
+}
+
+QskFlowLayoutEngine::~QskFlowLayoutEngine()
+{
+}
+
+Qt::Orientation QskFlowLayoutEngine::orientation() const
+{
+    return m_data->orientation;
+}
+
+bool QskFlowLayoutEngine::setOrientation( Qt::Orientation orientation )
+{
+    if ( m_data->orientation == orientation )
+        return false;
+
+    m_data->orientation = orientation;
+    m_data->resetLines();
+
+    return true;
+}
+
+bool QskFlowLayoutEngine::setVisualDirection( Qt::LayoutDirection direction )
+{
+    if ( m_data->visualDirection == direction )
+        return false;
+
+    m_data->visualDirection = direction;
+    m_data->laidOutLines = 0;
+
+    return true;
+}
+
+Qt::LayoutDirection QskFlowLayoutEngine::visualDirection() const
+{
+    return m_data->visualDirection;
+}
+
+bool QskFlowLayoutEngine::setDefaultAlignment( Qt::Alignment alignment )
+{
+    if ( m_data->defaultAlignment == alignment )
+        return false;
+
+    m_data->defaultAlignment = alignment;
+    m_data->laidOutLines = 0;
+
+    return true;
+}
+
+Qt::Alignment QskFlowLayoutEngine::defaultAlignment() const
+{
+    return m_data->defaultAlignment;
+}
+
+bool QskFlowLayoutEngine::setSpacing( qreal spacing, Qt::Orientations orientations )
+{
+    spacing = qMax( spacing, 0.0 );
+
+    bool isModified = false;
+
+    if ( ( orientations & Qt::Horizontal ) && spacing != m_data->horizontalSpacing )
+    {
+        m_data->horizontalSpacing = spacing;
+        isModified = true;
+    }
+
+    if ( ( orientations & Qt::Vertical ) && spacing != m_data->verticalSpacing )
+    {
+        m_data->verticalSpacing = spacing;
+        isModified = true;
+    }
+
+    if ( isModified )
+        m_data->resetLines();
+
+    return isModified;
+}
+
+qreal QskFlowLayoutEngine::spacing( Qt::Orientation orientation ) const
+{
+    return ( orientation == Qt::Horizontal )
+        ? m_data->horizontalSpacing : m_data->verticalSpacing;
+}
+
+int QskFlowLayoutEngine::count() const
+{
+    return m_data->elements.count();
+}
+
+int QskFlowLayoutEngine::insertItem( QQuickItem* item, int index )
+{
+    auto& elements = m_data->elements;
+
+    if ( index < 0 || index > elements.count() )
+        index = elements.count();
+
+    Element element;
+    element.item = item;
+
+    elements.insert( index, element );
+
+    m_data->setDirty( index );
+    m_data->checkHints = true;
+
+    return index;
+}
+
+bool QskFlowLayoutEngine::removeAt( int index )
+{
+    auto& elements = m_data->elements;
+
+    if ( index < 0 || index >= elements.count() )
+        return false;
+
+    elements.remove( index );
+    m_data->setDirty( index );
+
+    return true;
+}
+
+bool QskFlowLayoutEngine::clear()
+{
+    if ( m_data->elements.isEmpty() )
+        return false;
+
+    m_data->elements.clear();
+    m_data->resetLines();
+
+    return true;
+}
+
+QQuickItem* QskFlowLayoutEngine::itemAt( int index ) const
+{
+    const auto& elements = m_data->elements;
+
+    if ( index < 0 || index >= elements.count() )
+        return nullptr;
+
+    return elements[ index ].item;
+}
+
+int QskFlowLayoutEngine::indexOf( const QQuickItem* item ) const
+{
+    if ( item )
+    {
+        const auto& elements = m_data->elements;
+
+        for ( int i = elements.count() - 1; i >= 0; --i )
+        {
+            if ( elements[ i ].item == item )
+                return i;
+        }
+    }
+
+    return -1;
+}
+
+int QskFlowLayoutEngine::lineCount() const
+{
+    return m_data->lines.count();
+}
+
+void QskFlowLayoutEngine::invalidate()
+{
+    /*
+        We don't know which item has changed, but the items being
+        derived from QskControl can tell us by their serials.
+     */
+    m_data->checkHints = true;
+}
+
+void QskFlowLayoutEngine::updateHints() const
+{
+    if ( !m_data->checkHints )
+        return;
+
+    auto& elements = m_data->elements;
+
+    for ( int i = 0; i < elements.count(); i++ )
+    {
+        auto& element = elements[ i ];
+
+        const bool isIgnored = !qskIsVisibleToLayout( element.item );
+        if ( isIgnored != element.isIgnored )
+        {
+            element.isIgnored = isIgnored;
+            m_data->setDirty( i );
+        }
+
+        const auto serial = qskLayoutConstraintSerial( element.item );
+
+        if ( element.isValid && serial != 0 && serial == element.serial )
+            continue;
+
+        qskStatistics.hintQueries++;
+
+        const auto hint = qskEffectiveSizeHint(
+            element.item, Qt::PreferredSize ).expandedTo( QSizeF( 0.0, 0.0 ) );
+
+        /*
+            A changed serial might also indicate a different alignment,
+            so we always have to do the layout for its line again.
+         */
+        if ( serial != 0 || !element.isValid || hint != element.hint )
+            m_data->setDirty( i );
+
+        element.hint = hint;
+        element.serial = qskLayoutConstraintSerial( element.item );
+        element.isValid = true;
+    }
+
+    m_data->checkHints = false;
+}
+
+void QskFlowLayoutEngine::updateLines( qreal extent ) const
+{
+    updateHints();
+
+    auto& lines = m_data->lines;
+    const auto& elements = m_data->elements;
+
+    int firstLine = lines.count();
+    bool doReflow = false;
+
+    if ( m_data->firstDirty != qskNoDirtyElement )
+    {
+        /*
+            Changes of the first item of a line might also have an
+            effect on the line break of the previous line
+         */
+        firstLine = qMax( m_data->lineOf( m_data->firstDirty ) - 1, 0 );
+        doReflow = true;
+    }
+
+    if ( extent != m_data->lineExtent )
+    {
+        /*
+            As long as the lines still fit and the first item of the next
+            line does not fit into the available space, the breaks are the same.
+            Lines with items, that had to be shrunk, need a new layout.
+         */
+        const auto spacing = m_data->spacing( true );
+        const auto minExtent = qMin( extent, m_data->lineExtent );
+
+        for ( int i = 0; i < firstLine; i++ )
+        {
+            const auto& line = lines[ i ];
+
+            bool isAffected = ( line.extent > minExtent );
+
+            if ( !isAffected && ( i < lines.count() - 1 ) )
+                isAffected = line.extent + spacing + lines[ i + 1 ].firstExtent <= extent;
+
+            if ( isAffected )
+            {
+                firstLine = i;
+                doReflow = true;
+
+                break;
+            }
+        }
+    }
+
+    m_data->lineExtent = extent;
+    m_data->firstDirty = qskNoDirtyElement;
+
+    if ( !doReflow )
+        return;
+
+    qskStatistics.reflows++;
+
+    lines.resize( firstLine );
+
+    m_data->laidOutLines = qMin( m_data->laidOutLines, firstLine );
+
+    const auto spacingAlong = m_data->spacing( true );
+    const auto spacingAcross = m_data->spacing( false );
+
+    Line line;
+
+    if ( !lines.isEmpty() )
+    {
+        const auto& lastLine = lines.last();
+
+        line.first = lastLine.end;
+        line.position = lastLine.position + lastLine.thickness + spacingAcross;
+    }
+
+    for ( int i = line.first; i < elements.count(); i++ )
+    {
+        const auto& element = elements[ i ];
+
+        if ( element.isIgnored )
+            continue;
+
+        const auto along = m_data->along( element.hint );
+        const auto across = m_data->across( element.hint );
+
+        if ( line.itemCount > 0 && line.extent + spacingAlong + along > extent )
+        {
+            line.end = i;
+            lines += line;
+
+            qskStatistics.reflowedLines++;
+
+            const auto position = line.position + line.thickness + spacingAcross;
+
+            line = Line();
+            line.first = i;
+            line.position = position;
+        }
+
+        if ( line.itemCount == 0 )
+        {
+            line.extent = line.firstExtent = along;
+        }
+        else
+        {
+            line.extent += spacingAlong + along;
+        }
+
+        line.thickness = qMax( line.thickness, across );
+        line.itemCount++;
+    }
+
+    if ( line.itemCount > 0 )
+    {
+        line.end = elements.count();
+        lines += line;
+
+        qskStatistics.reflowedLines++;
+    }
+    else if ( !lines.isEmpty() )
+    {
+        // trailing ignored elements
+        lines.last().end = elements.count();
+    }
+}
+
+QSizeF QskFlowLayoutEngine::sizeHint(
+    Qt::SizeHint which, const QSizeF& constraint ) const
+{
+    if ( which == Qt::MaximumSize )
+        return QSizeF();
+
+    const auto extent = m_data->along( constraint );
+
+    if ( extent >= 0.0 )
+    {
+        /*
+            Only the extent of the last layout can be answered from the
+            cached lines. Other constraints are calculated in a local pass,
+            so that probing f.e. heightForWidth does not invalidate the line
+            breaks for the geometry of the box.
+         */
+        qreal thickness = 0.0;
+
+        if ( extent == m_data->lineExtent )
+        {
+            updateLines( extent );
+
+            const auto& lines = m_data->lines;
+            if ( !lines.isEmpty() )
+                thickness = lines.last().position + lines.last().thickness;
+        }
+        else
+        {
+            updateHints();
+            thickness = m_data->thickness( extent );
+        }
+
+        return m_data->size( -1.0, thickness );
+    }
+
+    updateHints();
+
+    /*
+        Without a constraint all items are in one line, what is
+        the preferred size. The minimum is the widest item.
+     */
+
+    qreal along = 0.0;
+    qreal across = 0.0;
+
+    int itemCount = 0;
+
+    for ( const auto& element : qAsConst( m_data->elements ) )
+    {
+        if ( element.isIgnored )
+            continue;
+
+        const auto hintAlong = m_data->along( element.hint );
+
+        if ( which == Qt::MinimumSize )
+            along = qMax( along, hintAlong );
+        else
+            along += hintAlong;
+
+        across = qMax( across, m_data->across( element.hint ) );
+        itemCount++;
+    }
+
+    if ( which == Qt::MinimumSize )
+        return m_data->size( along, -1.0 );
+
+    if ( itemCount > 1 )
+        along += ( itemCount - 1 ) * m_data->spacing( true );
+
+    return m_data->size( along, across );
+}
+
+void QskFlowLayoutEngine::setGeometries( const QRectF& rect )
+{
+    const auto extent = m_data->along( rect.size() );
+
+    updateLines( extent );
+
+    auto direction = m_data->visualDirection;
+    if ( direction == Qt::LayoutDirectionAuto )
+        direction = QGuiApplication::layoutDirection();
+
+    const bool isMirrored = ( direction == Qt::RightToLeft );
+
+    {
+        /*
+            With a left to right direction the positions of
+            the lines do not depend on the size of the rectangle.
+         */
+
+        const auto& oldRect = m_data->layoutRect;
+
+        if ( rect.topLeft() != oldRect.topLeft()
+            || ( isMirrored && rect.size() != oldRect.size() ) )
+        {
+            m_data->laidOutLines = 0;
+        }
+
+        m_data->layoutRect = rect;
+    }
+
+    const auto& lines = m_data->lines;
+    const auto& elements = m_data->elements;
+
+    const auto spacing = m_data->spacing( true );
+    const bool isHorizontal = ( m_data->orientation == Qt::Horizontal );
+
+    for ( int i = m_data->laidOutLines; i < lines.count(); i++ )
+    {
+        const auto& line = lines[ i ];
+
+        qreal pos = 0.0;
+
+        for ( int j = line.first; j < line.end; j++ )
+        {
+            const auto& element = elements[ j ];
+            if ( element.isIgnored )
+                continue;
+
+            const auto along = qMin( m_data->along( element.hint ), extent );
+
+            QRectF cellRect;
+            if ( isHorizontal )
+                cellRect.setRect( rect.x() + pos, rect.y() + line.position, along, line.thickness );
+            else
+                cellRect.setRect( rect.x() + line.position, rect.y() + pos, line.thickness, along );
+
+            pos += along + spacing;
+
+            auto alignment = qskLayoutAlignmentHint( element.item );
+            alignment = m_data->effectiveAlignment( alignment );
+
+            auto itemRect = qskConstrainedItemRect( element.item, cellRect, alignment );
+
+            if ( isMirrored )
+                itemRect.moveRight( rect.right() - ( itemRect.left() - rect.left() ) );
+
+            qskSetItemGeometry( element.item, itemRect );
+        }
+    }
+
+    m_data->laidOutLines = lines.count();
+}
+
+QskFlowLayoutEngine::Statistics QskFlowLayoutEngine::statistics()
+{
+    return qskStatistics;
+}
+
+void QskFlowLayoutEngine::resetStatistics()
+{
+    qskStatistics = Statistics();
+}
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_FLOW_LAYOUT_ENGINE_H
+#define QSK_FLOW_LAYOUT_ENGINE_H
+
+#include "QskGlobal.h"
+
+#include <qnamespace.h>
+#include <memory>
+
+class QQuickItem;
+class QSizeF;
+class QRectF;
+
+/*
+    Items are arranged in lines, that are wrapped, when the next item
+    does not fit into the available extent. For Qt::Horizontal the lines
+    are rows - for Qt::Vertical they are columns.
+
+    The preferred sizes of the items are cached and only queried again for
+    items, that have notified about changes. When the available extent
+    changes, the line breaks are recalculated from the first line onward,
+    that does not have the same break anymore.
+ */
+class QskFlowLayoutEngine
+{
+  public:
+    class Statistics
+    {
+      public:
+        // accumulated over all engines
+        quint64 hintQueries = 0;
+        quint64 reflows = 0;
+        quint64 reflowedLines = 0;
+    };
+
+    QskFlowLayoutEngine( Qt::Orientation );
+    ~QskFlowLayoutEngine();
+
+    Qt::Orientation orientation() const;
+    bool setOrientation( Qt::Orientation );
+
+    bool setVisualDirection( Qt::LayoutDirection );
+    Qt::LayoutDirection visualDirection() const;
+
+    bool setDefaultAlignment( Qt::Alignment );
+    Qt::Alignment defaultAlignment() const;
+
+    bool setSpacing( qreal spacing, Qt::Orientations );
+    qreal spacing( Qt::Orientation ) const;
+
+    int count() const;
+
+    int insertItem( QQuickItem*, int index );
+    int addItem( QQuickItem* );
+
+    bool removeAt( int index );
+    bool clear();
+
+    QQuickItem* itemAt( int index ) const;
+    int indexOf( const QQuickItem* ) const;
+
+    // the number of lines of the most recent calculation
+    int lineCount() const;
+
+    void invalidate();
+
+    QSizeF sizeHint( Qt::SizeHint, const QSizeF& constraint ) const;
+    void setGeometries( const QRectF& );
+
+    // layouting is done in the GUI thread only
+    QSK_EXPORT static Statistics statistics();
+    QSK_EXPORT static void resetStatistics();
+
+  private:
+    Q_DISABLE_COPY( QskFlowLayoutEngine )
+
+    void updateHints() const;
+    void updateLines( qreal extent ) const;
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+inline int QskFlowLayoutEngine::addItem( QQuickItem* item )
+{
+    return insertItem( item, -1 );
+}
+
+#endif
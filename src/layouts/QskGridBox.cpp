@@ -43,36 +43,17 @@ static void qskUpdateFocusChain(
     QskGridBox* box, const QskGridLayoutEngine* engine,
     QQuickItem* item, const QRect& grid )
 {
-    /*
-        We are running over all entries each time an item gets inserted.
-        There should be a faster way TODO ...
-     */
-
-    const int cellIndex = grid.y() * engine->columnCount() + grid.x();
-
-    QQuickItem* itemNext = nullptr;
-    int minDelta = -1;
+    auto index = engine->nextItemIndex( grid.y(), grid.x() );
 
-    for ( int i = 0; i < engine->count(); i++ )
+    if ( engine->itemAt( index ) == item )
     {
-        const auto itemAt = engine->itemAt( i );
-
-        if ( itemAt && item != itemAt )
-        {
-            const auto gridAt = engine->gridAt( i );
-            const int delta = gridAt.y() * engine->columnCount() + gridAt.x() - cellIndex;
-
-            if ( delta > 0 )
-            {
-                if ( itemNext == nullptr || delta < minDelta )
-                {
-                    itemNext = itemAt;
-                    minDelta = delta;
-                }
-            }
-        }
+        // item has been inserted before with a different grid
+        const auto itemGrid = engine->gridAt( index );
+        index = engine->nextItemIndex( itemGrid.y(), itemGrid.x() );
     }
 
+    const auto itemNext = engine->itemAt( index );
+
     if ( itemNext )
     {
         item->stackBefore( itemNext );
@@ -183,6 +164,12 @@ int QskGridBox::addItem( QQuickItem* item,
 int QskGridBox::addSpacer( const QSizeF& spacing,
     int row, int column, int rowSpan, int columnSpan )
 {
+    if ( row < 0 || column < 0 )
+        return -1;
+
+    rowSpan = qMax( rowSpan, -1 );
+    columnSpan = qMax( columnSpan, -1 );
+
     const int index = m_data->engine.insertSpacer(
         spacing, QRect( column, row, columnSpan, rowSpan ) );
 
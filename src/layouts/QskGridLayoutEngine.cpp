@@ -11,15 +11,29 @@
 
 #include <qvector.h>
 
+#include <algorithm>
+#include <map>
 #include <vector>
 #include <functional>
 
+/*
+    Up to this number of cells lookups are done from a
+    dense table, that is built on demand
+ */
+static const int qskMaxDenseCells = 4096;
+
 static inline qreal qskSegmentLength(
     const QskLayoutChain::Segments& s, int start, int end )
 {
     return s[ end ].start - s[ start ].start + s[ end ].length;
 }
 
+static inline bool qskIsUnlimited( const QRect& grid )
+{
+    // the effective grid depends on the row/column counts
+    return grid.width() <= 0 || grid.height() <= 0;
+}
+
 namespace
 {
     class Settings
@@ -299,6 +313,356 @@ void Element::transpose()
         m_grid.height(), m_grid.width() );
 }
 
+namespace
+{
+    /*
+        An occupancy index for the cells of the grid: an interval map, that
+        splits the rows into bands, where each band is a range of rows
+        with the same column intervals of the elements. The intervals
+        are sorted by their first column.
+
+        An element spanning many rows is not stored for each row, but for
+        the bands only. So memory and time depend on the number of
+        elements and not on the extent of the grid.
+
+        The index knows about element indexes and grids only. Elements
+        with an unlimited span are not included as their effective grid
+        depends on the number of rows/columns.
+     */
+    class CellIndex
+    {
+      public:
+        void clear()
+        {
+            m_bands.clear();
+            m_table.clear();
+            m_tableValid = false;
+        }
+
+        void insert( int index, const QRect& grid )
+        {
+            const auto from = split( grid.top() );
+            const auto to = split( grid.bottom() + 1 );
+
+            const Span span { grid.left(), grid.right(), grid.top(), index };
+
+            for ( auto it = from; it != to; ++it )
+                it->second.insert( span );
+
+            m_tableValid = false;
+        }
+
+        void remove( int index, const QRect& grid )
+        {
+            if ( m_bands.empty() )
+                return;
+
+            const auto from = split( grid.top() );
+            const auto to = split( grid.bottom() + 1 );
+
+            for ( auto it = from; it != to; ++it )
+                it->second.remove( index, grid.left() );
+
+            merge( grid.bottom() + 1 );
+            merge( grid.top() );
+
+            m_tableValid = false;
+        }
+
+        // renumbering after an element has been erased
+        void shiftIndexes( int erasedIndex )
+        {
+            for ( auto& band : m_bands )
+            {
+                for ( auto& span : band.second.spans )
+                {
+                    if ( span.index > erasedIndex )
+                        span.index--;
+                }
+            }
+
+            m_tableValid = false;
+        }
+
+        int indexAt( int row, int column ) const
+        {
+            if ( row < 0 || column < 0 || row >= rowCount() )
+                return -1;
+
+            if ( !m_tableValid )
+                updateTable();
+
+            if ( !m_table.empty() )
+            {
+                if ( column >= m_tableColumns )
+                    return -1;
+
+                return m_table[ row * m_tableColumns + column ];
+            }
+
+            const auto it = bandAt( row );
+            return ( it != m_bands.end() ) ? it->second.indexAt( column ) : -1;
+        }
+
+        /*
+            The element with the lowest index, whose origin is the first
+            one after row/column in row-major order
+         */
+        void findNextOrigin( int row, int column,
+            const std::function< bool( int ) >& accept, int& nextRow, int& nextIndex ) const
+        {
+            nextRow = nextIndex = -1;
+
+            if ( row >= rowCount() )
+                return;
+
+            /*
+                The origin of a span is in the band, that contains its
+                top row. So the first band with a matching origin
+                has the result.
+             */
+            int first = -1;
+
+            auto it = bandAt( row );
+            if ( it == m_bands.end() )
+                it = m_bands.begin();
+
+            for ( ; it != m_bands.end(); ++it )
+            {
+                for ( const auto& span : it->second.spans )
+                {
+                    if ( span.top < it->first || span.top < row )
+                        continue;
+
+                    if ( span.top == row && span.first <= column )
+                        continue;
+
+                    if ( nextRow >= 0 )
+                    {
+                        if ( span.top > nextRow )
+                            continue;
+
+                        if ( span.top == nextRow )
+                        {
+                            if ( span.first > first )
+                                continue;
+
+                            if ( span.first == first && span.index > nextIndex )
+                                continue;
+                        }
+                    }
+
+                    if ( accept( span.index ) )
+                    {
+                        nextRow = span.top;
+                        nextIndex = span.index;
+                        first = span.first;
+                    }
+                }
+
+                if ( nextRow >= 0 )
+                    return;
+            }
+        }
+
+      private:
+        class Span
+        {
+          public:
+            inline bool operator==( const Span& other ) const
+            {
+                return ( first == other.first ) && ( last == other.last )
+                    && ( top == other.top ) && ( index == other.index );
+            }
+
+            int first;
+            int last;
+            int top; // the origin row of the element
+            int index;
+        };
+
+        class Band
+        {
+          public:
+            void insert( const Span& span )
+            {
+                auto it = std::upper_bound( spans.begin(), spans.end(), span.first,
+                    []( int first, const Span& s ) { return first < s.first; } );
+
+                if ( !isOverlapping )
+                {
+                    isOverlapping = ( it != spans.end() && it->first <= span.last )
+                        || ( it != spans.begin() && ( it - 1 )->last >= span.first );
+                }
+
+                spans.insert( it, span );
+            }
+
+            void remove( int index, int first )
+            {
+                auto it = std::lower_bound( spans.begin(), spans.end(), first,
+                    []( const Span& s, int first ) { return s.first < first; } );
+
+                for ( ; it != spans.end() && it->first == first; ++it )
+                {
+                    if ( it->index == index )
+                    {
+                        spans.erase( it );
+                        break;
+                    }
+                }
+
+                if ( spans.empty() )
+                    isOverlapping = false;
+            }
+
+            int indexAt( int column ) const
+            {
+                auto it = std::upper_bound( spans.begin(), spans.end(), column,
+                    []( int column, const Span& s ) { return column < s.first; } );
+
+                if ( !isOverlapping )
+                {
+                    if ( it != spans.begin() && ( it - 1 )->last >= column )
+                        return ( it - 1 )->index;
+
+                    return -1;
+                }
+
+                int index = -1;
+
+                for ( auto span = spans.begin(); span != it; ++span )
+                {
+                    if ( span->last >= column && ( index < 0 || span->index < index ) )
+                        index = span->index;
+                }
+
+                return index;
+            }
+
+            std::vector< Span > spans;
+
+            // not reset before the band becomes empty
+            bool isOverlapping = false;
+        };
+
+        /*
+            Each band starts at its key and ends at the key of the next band.
+            The last band is always empty and marks the end of the grid.
+         */
+        using Bands = std::map< int, Band >;
+
+        inline int rowCount() const
+        {
+            return m_bands.empty() ? 0 : m_bands.rbegin()->first;
+        }
+
+        // the band containing row, end() for the empty rows above the first band
+        inline Bands::const_iterator bandAt( int row ) const
+        {
+            const auto it = m_bands.upper_bound( row );
+            return ( it == m_bands.begin() ) ? m_bands.end() : std::prev( it );
+        }
+
+        // a band starting at row
+        Bands::iterator split( int row )
+        {
+            auto it = m_bands.upper_bound( row );
+
+            if ( it == m_bands.begin() )
+            {
+                // the rows above the first band are empty
+                return m_bands.emplace_hint( it, row, Band() );
+            }
+
+            const auto band = std::prev( it );
+            if ( band->first == row )
+                return band;
+
+            return m_bands.emplace_hint( it, row, band->second );
+        }
+
+        // joining the band starting at row with the band above
+        void merge( int row )
+        {
+            auto it = m_bands.find( row );
+            if ( it == m_bands.end() )
+                return;
+
+            if ( it == m_bands.begin() )
+            {
+                if ( it->second.spans.empty() )
+                    m_bands.erase( it );
+
+                return;
+            }
+
+            const auto band = std::prev( it );
+            if ( band->second.spans == it->second.spans )
+            {
+                m_bands.erase( it );
+                it = band;
+            }
+
+            if ( it == m_bands.begin() && it->second.spans.empty() )
+                m_bands.erase( it );
+        }
+
+        void updateTable() const
+        {
+            m_table.clear();
+            m_tableColumns = 0;
+
+            for ( const auto& band : m_bands )
+            {
+                for ( const auto& span : band.second.spans )
+                    m_tableColumns = qMax( m_tableColumns, span.last + 1 );
+            }
+
+            const int rowCount = this->rowCount();
+
+            if ( rowCount * m_tableColumns <= qskMaxDenseCells )
+            {
+                m_table.assign( rowCount * m_tableColumns, -1 );
+
+                for ( auto it = m_bands.begin(); it != m_bands.end(); ++it )
+                {
+                    const auto next = std::next( it );
+                    if ( next == m_bands.end() )
+                        break;
+
+                    auto cells = m_table.data() + it->first * m_tableColumns;
+
+                    for ( const auto& span : it->second.spans )
+                    {
+                        for ( int c = span.first; c <= span.last; c++ )
+                        {
+                            if ( cells[ c ] < 0 || span.index < cells[ c ] )
+                                cells[ c ] = span.index;
+                        }
+                    }
+
+                    // all rows of the band are the same
+                    for ( int r = it->first + 1; r < next->first; r++ )
+                    {
+                        std::copy( cells, cells + m_tableColumns,
+                            m_table.data() + r * m_tableColumns );
+                    }
+                }
+            }
+
+            m_tableValid = true;
+        }
+
+        Bands m_bands;
+
+        // row-major, only for small grids
+        mutable std::vector< int > m_table;
+        mutable int m_tableColumns = 0;
+        mutable bool m_tableValid = false;
+    };
+}
+
 class QskGridLayoutEngine::PrivateData
 {
   public:
@@ -313,6 +677,9 @@ class QskGridLayoutEngine::PrivateData
 
     int insertElement( QQuickItem* item, QSizeF spacing, QRect grid )
     {
+        if ( grid.left() < 0 || grid.top() < 0 )
+            return -1;
+
         // -1 means unlimited, while 0 does not make any sense
         if ( grid.width() == 0 )
             grid.setWidth( 1 );
@@ -335,12 +702,59 @@ class QskGridLayoutEngine::PrivateData
             elements.push_back( Element( spacing, grid ) );
         }
 
+        const int index = elements.size() - 1;
+        addToIndex( index );
+
         grid = effectiveGrid( elements.back() );
 
         rowCount = qMax( rowCount, grid.bottom() + 1 );
         columnCount = qMax( columnCount, grid.right() + 1 );
 
-        return this->elements.size() - 1;
+        return index;
+    }
+
+    void addToIndex( int index )
+    {
+        const auto grid = elements[ index ].grid();
+
+        if ( qskIsUnlimited( grid ) )
+        {
+            auto it = std::lower_bound(
+                unlimitedElements.begin(), unlimitedElements.end(), index );
+
+            unlimitedElements.insert( it, index );
+        }
+        else
+        {
+            cellIndex.insert( index, grid );
+        }
+    }
+
+    void removeFromIndex( int index )
+    {
+        const auto grid = elements[ index ].grid();
+
+        if ( qskIsUnlimited( grid ) )
+        {
+            auto it = std::lower_bound(
+                unlimitedElements.begin(), unlimitedElements.end(), index );
+
+            if ( it != unlimitedElements.end() && *it == index )
+                unlimitedElements.erase( it );
+        }
+        else
+        {
+            cellIndex.remove( index, grid );
+        }
+    }
+
+    void rebuildIndex()
+    {
+        cellIndex.clear();
+        unlimitedElements.clear();
+
+        for ( uint i = 0; i < elements.size(); i++ )
+            addToIndex( i );
     }
 
     QRect effectiveGrid( const Element& element ) const
@@ -365,6 +779,9 @@ class QskGridLayoutEngine::PrivateData
 
     std::vector< Element > elements;
 
+    CellIndex cellIndex;
+    std::vector< int > unlimitedElements; // sorted
+
     Settings rowSettings;
     Settings columnSettings;
 
@@ -477,9 +894,19 @@ bool QskGridLayoutEngine::removeAt( int index )
 
     const auto grid = element->minimumGrid();
 
+    m_data->removeFromIndex( index );
+
     auto& elements = m_data->elements;
     elements.erase( elements.begin() + index );
 
+    m_data->cellIndex.shiftIndexes( index );
+
+    for ( auto& i : m_data->unlimitedElements )
+    {
+        if ( i > index )
+            i--;
+    }
+
     // doing a lazy recalculation instead ??
 
     if ( grid.bottom() >= m_data->rowCount
@@ -507,6 +934,8 @@ bool QskGridLayoutEngine::removeAt( int index )
 bool QskGridLayoutEngine::clear()
 {
     m_data->elements.clear();
+    m_data->cellIndex.clear();
+    m_data->unlimitedElements.clear();
     m_data->rowSettings.clear();
     m_data->columnSettings.clear();
 
@@ -516,17 +945,75 @@ bool QskGridLayoutEngine::clear()
 
 int QskGridLayoutEngine::indexAt( int row, int column ) const
 {
-    if ( row < m_data->rowCount && column < m_data->columnCount )
+    if ( row < 0 || column < 0
+        || row >= m_data->rowCount || column >= m_data->columnCount )
+    {
+        return -1;
+    }
+
+    const int index = m_data->cellIndex.indexAt( row, column );
+
+    // elements with an unlimited span are usually rare
+
+    for ( const auto i : m_data->unlimitedElements )
+    {
+        if ( index >= 0 && i > index )
+            break;
+
+        const auto grid = m_data->effectiveGrid( m_data->elements[ i ] );
+        if ( grid.contains( column, row ) )
+            return i;
+    }
+
+    return index;
+}
+
+int QskGridLayoutEngine::nextItemIndex( int row, int column ) const
+{
+    const auto& elements = m_data->elements;
+
+    auto isItem = [ &elements ]( int index )
+        { return elements[ index ].item() != nullptr; };
+
+    int nextRow, nextIndex;
+    m_data->cellIndex.findNextOrigin( row, column, isItem, nextRow, nextIndex );
+
+    int nextColumn = ( nextIndex >= 0 ) ? elements[ nextIndex ].grid().left() : -1;
+
+    for ( const auto i : m_data->unlimitedElements )
     {
-        for ( uint i = 0; i < m_data->elements.size(); i++ )
+        if ( !isItem( i ) )
+            continue;
+
+        const auto grid = elements[ i ].grid();
+
+        const bool isAfter = ( grid.top() > row )
+            || ( grid.top() == row && grid.left() > column );
+
+        if ( !isAfter )
+            continue;
+
+        if ( nextIndex >= 0 )
         {
-            const auto grid = m_data->effectiveGrid( m_data->elements[i] );
-            if ( grid.contains( column, row ) )
-                return i;
+            if ( grid.top() > nextRow )
+                continue;
+
+            if ( grid.top() == nextRow )
+            {
+                if ( grid.left() > nextColumn )
+                    continue;
+
+                if ( grid.left() == nextColumn && i > nextIndex )
+                    continue;
+            }
         }
+
+        nextRow = grid.top();
+        nextColumn = grid.left();
+        nextIndex = i;
     }
 
-    return -1;
+    return nextIndex;
 }
 
 QQuickItem* QskGridLayoutEngine::itemAt( int index ) const
@@ -552,11 +1039,17 @@ QQuickItem* QskGridLayoutEngine::itemAt( int row, int column ) const
 
 bool QskGridLayoutEngine::setGridAt( int index, const QRect& grid )
 {
+    if ( grid.left() < 0 || grid.top() < 0 )
+        return false;
+
     if ( auto element = m_data->elementAt( index ) )
     {
         if ( element->grid() != grid )
         {
+            m_data->removeFromIndex( index );
             element->setGrid( grid );
+            m_data->addToIndex( index );
+
             invalidate();
 
             return true;
@@ -608,6 +1101,8 @@ void QskGridLayoutEngine::transpose()
     qSwap( m_data->columnSettings, m_data->rowSettings );
     qSwap( m_data->columnCount, m_data->rowCount );
 
+    m_data->rebuildIndex();
+
     invalidate();
 }
 
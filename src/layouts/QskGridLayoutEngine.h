@@ -45,6 +45,9 @@ class QskGridLayoutEngine : public QskLayoutEngine2D
     QQuickItem* itemAt( int row, int column ) const;
     int indexAt( int row, int column ) const;
 
+    // the first item, whose grid starts after row/column in row-major order
+    int nextItemIndex( int row, int column ) const;
+
     bool setGridAt( int index, const QRect& );
     QRect gridAt( int index ) const;
 
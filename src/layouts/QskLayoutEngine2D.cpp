@@ -6,10 +6,28 @@
 #include "QskLayoutEngine2D.h"
 #include "QskLayoutChain.h"
 #include "QskLayoutMetrics.h"
+#include "QskLayoutProfiler.h"
 #include "QskControl.h"
 #include "QskQuick.h"
 
 #include <qguiapplication.h>
+#include <qhash.h>
+#include <qvarlengtharray.h>
+
+/*
+    Number of chains being kept for the most recent constraints. Nested
+    boxes usually ask for the same few widths/heights over and over.
+ */
+static const int qskChainCacheSize = 4;
+
+/*
+    Number of metrics being kept for each item: the unconstrained
+    ones for both orientations and the constrained ones of the chains
+    in the cache
+ */
+static const int qskMetricsCacheSize = 2 + qskChainCacheSize;
+
+static QskLayoutEngine2D::Statistics qskStatistics;
 
 static QSizeF qskItemConstraint( const QQuickItem* item, const QSizeF& constraint )
 {
@@ -123,6 +141,140 @@ namespace
     };
 }
 
+namespace
+{
+    class ChainCache
+    {
+      public:
+        bool restore( Qt::Orientation orientation,
+            qreal constraint, int count, QskLayoutChain& chain )
+        {
+            for ( int i = 0; i < m_entries.count(); i++ )
+            {
+                const auto& entry = m_entries[ i ];
+
+                if ( entry.orientation == orientation
+                    && entry.chain.constraint() == constraint
+                    && entry.chain.count() == count )
+                {
+                    chain = entry.chain; // implicitly shared
+
+                    if ( i > 0 )
+                        m_entries.move( i, 0 );
+
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void insert( Qt::Orientation orientation, const QskLayoutChain& chain )
+        {
+            if ( m_entries.count() >= qskChainCacheSize )
+                m_entries.removeLast();
+
+            m_entries.prepend( { orientation, chain } );
+        }
+
+        void clear()
+        {
+            m_entries.clear();
+        }
+
+      private:
+        class Entry
+        {
+          public:
+            Qt::Orientation orientation;
+            QskLayoutChain chain;
+        };
+
+        // the most recently used first
+        QVector< Entry > m_entries;
+    };
+}
+
+namespace
+{
+    /*
+        The metrics of the items are kept until the serial of an item
+        has been changed. So when a single item sends a LayoutRequest
+        only this item has to be queried again, when rebuilding the chains.
+     */
+    class MetricsCache
+    {
+      public:
+        bool find( const QQuickItem* item, quint64 serial,
+            Qt::Orientation orientation, qreal constraint,
+            QskLayoutMetrics& metrics ) const
+        {
+            const auto it = m_entries.constFind( item );
+            if ( it == m_entries.constEnd() || it->serial != serial )
+                return false;
+
+            for ( const auto& slot : it->slots )
+            {
+                if ( slot.orientation == orientation
+                    && slot.constraint == constraint )
+                {
+                    metrics = slot.metrics;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void insert( const QQuickItem* item, quint64 serial,
+            Qt::Orientation orientation, qreal constraint,
+            const QskLayoutMetrics& metrics, int itemCount )
+        {
+            if ( m_entries.size() > 2 * itemCount + 8 )
+            {
+                // dropping the entries of items, that are not in the layout anymore
+                m_entries.clear();
+            }
+
+            auto& entry = m_entries[ item ];
+
+            if ( entry.serial != serial )
+            {
+                entry.serial = serial;
+                entry.slots.clear();
+            }
+
+            if ( entry.slots.size() >= qskMetricsCacheSize )
+                entry.slots.remove( 0 );
+
+            entry.slots.append( { orientation, constraint, metrics } );
+        }
+
+        void clear()
+        {
+            m_entries.clear();
+        }
+
+      private:
+        class Slot
+        {
+          public:
+            Qt::Orientation orientation;
+            qreal constraint;
+            QskLayoutMetrics metrics;
+        };
+
+        class Entry
+        {
+          public:
+            quint64 serial = 0;
+            QVarLengthArray< Slot, qskMetricsCacheSize > slots;
+        };
+
+        QHash< const QQuickItem*, Entry > m_entries;
+    };
+}
+
 class QskLayoutEngine2D::PrivateData
 {
   public:
@@ -156,6 +308,12 @@ class QskLayoutEngine2D::PrivateData
     QskLayoutChain columnChain;
     QskLayoutChain rowChain;
 
+    // constrained chains for the most recent constraints
+    ChainCache chainCache;
+
+    // metrics of the items, that did not change since the last query
+    MetricsCache metricsCache;
+
     QSizeF layoutSize;
 
     QskLayoutChain::Segments rows;
@@ -286,6 +444,9 @@ bool QskLayoutEngine2D::setExtraSpacingAt( Qt::Edges edges )
     m_data->rows.clear();
     m_data->columns.clear();
 
+    // the cached chains have the previous fill mode
+    m_data->chainCache.clear();
+
     return true;
 }
 
@@ -483,6 +644,9 @@ QskLayoutMetrics QskLayoutEngine2D::layoutMetrics( const QQuickItem* item,
     if ( item == nullptr )
         return QskLayoutMetrics();
 
+    qskStatistics.layoutMetricsCalls++;
+    QskLayoutProfiler::countLayoutMetrics();
+
     const auto policy = qskSizePolicy( item ).policy( orientation );
 
     if ( constraint >= 0.0 )
@@ -491,6 +655,19 @@ QskLayoutMetrics QskLayoutEngine2D::layoutMetrics( const QQuickItem* item,
             constraint = -1.0;
     }
 
+    const auto serial = qskLayoutConstraintSerial( item );
+    if ( serial > 0 )
+    {
+        QskLayoutMetrics metrics;
+
+        if ( m_data->metricsCache.find(
+            item, serial, orientation, constraint, metrics ) )
+        {
+            qskStatistics.metricsCacheHits++;
+            return metrics;
+        }
+    }
+
     qreal minimum, preferred, maximum;
 
     const auto expandFlags = QskSizePolicy::GrowFlag | QskSizePolicy::ExpandFlag;
@@ -522,7 +699,21 @@ QskLayoutMetrics QskLayoutEngine2D::layoutMetrics( const QQuickItem* item,
             preferred = minimum;
     }
 
-    return QskLayoutMetrics( minimum, preferred, maximum );
+    const QskLayoutMetrics metrics( minimum, preferred, maximum );
+
+    if ( serial > 0 )
+    {
+        /*
+            Calculating the hints might have changed the serial, f.e when
+            the item updated its implicit size lazily. Then the metrics
+            have been calculated from the updated state and we can store
+            them for the current serial.
+         */
+        m_data->metricsCache.insert( item, qskLayoutConstraintSerial( item ),
+            orientation, constraint, metrics, count() );
+    }
+
+    return metrics;
 }
 
 void QskLayoutEngine2D::setupChain( Qt::Orientation orientation ) const
@@ -544,10 +735,32 @@ void QskLayoutEngine2D::setupChain( Qt::Orientation orientation,
         return; // already up to date
     }
 
+    if ( constraint >= 0.0 )
+    {
+        /*
+            The constraints are calculated from the other chain, that
+            does not depend on any constraint. So as long as the layout
+            has not been invalidated the total size is a sufficient key.
+         */
+
+        if ( m_data->chainCache.restore( orientation, constraint, count, chain ) )
+        {
+            qskStatistics.chainCacheHits++;
+            return;
+        }
+
+        qskStatistics.chainCacheMisses++;
+    }
+
+    QskLayoutProfiler::countChainRebuild();
+
     chain.reset( count, constraint );
     setupChain( orientation, constraints, chain );
     chain.finish();
 
+    if ( constraint >= 0.0 )
+        m_data->chainCache.insert( orientation, chain );
+
 #if 0
     qDebug() << "==" << this << orientation << chain.count();
 
@@ -616,6 +829,7 @@ void QskLayoutEngine2D::invalidate( int what )
     {
         m_data->rowChain.invalidate();
         m_data->columnChain.invalidate();
+        m_data->chainCache.clear();
 
         m_data->layoutSize = QSize();
         m_data->rows.clear();
@@ -652,3 +866,13 @@ QskSizePolicy::ConstraintType QskLayoutEngine2D::constraintType() const
 
     return static_cast< QskSizePolicy::ConstraintType >( m_data->constraintType );
 }
+
+QskLayoutEngine2D::Statistics QskLayoutEngine2D::statistics()
+{
+    return qskStatistics;
+}
+
+void QskLayoutEngine2D::resetStatistics()
+{
+    qskStatistics = Statistics();
+}
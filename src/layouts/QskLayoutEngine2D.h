@@ -19,6 +19,20 @@ class QskLayoutMetrics;
 class QskLayoutEngine2D
 {
   public:
+    class Statistics
+    {
+      public:
+        // accumulated over all engines
+        quint64 layoutMetricsCalls = 0;
+
+        // layoutMetrics() answered without querying the item
+        quint64 metricsCacheHits = 0;
+
+        // chains of constrained layouts, see sizeHint()
+        quint64 chainCacheHits = 0;
+        quint64 chainCacheMisses = 0;
+    };
+
     QskLayoutEngine2D();
     virtual ~QskLayoutEngine2D();
 
@@ -54,6 +68,10 @@ class QskLayoutEngine2D
 
     void setGeometries( const QRectF& );
 
+    // layouting is done in the GUI thread only
+    QSK_EXPORT static Statistics statistics();
+    QSK_EXPORT static void resetStatistics();
+
   protected:
 
     void layoutItem( QQuickItem*, const QRect& grid ) const;
@@ -0,0 +1,261 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskLayoutProfiler.h"
+
+#include <qdebug.h>
+#include <qelapsedtimer.h>
+#include <qhash.h>
+#include <qquickitem.h>
+
+#include <algorithm>
+
+static QskLayoutProfiler* qskProfiler = nullptr;
+
+static QString qskItemName( const QQuickItem* item )
+{
+    auto name = QString::fromLatin1( item->metaObject()->className() );
+
+    if ( !item->objectName().isEmpty() )
+        name += QStringLiteral( " \"%1\"" ).arg( item->objectName() );
+
+    name += QStringLiteral( " (0x%1)" ).arg( quintptr( item ), 0, 16 );
+
+    return name;
+}
+
+class QskLayoutProfiler::PrivateData
+{
+  public:
+    PrivateData( bool debugAtDestruction )
+        : debugAtDestruction( debugAtDestruction )
+    {
+        clock.start();
+    }
+
+    Record& record( const QQuickItem* item )
+    {
+        auto it = records.find( item );
+        if ( it == records.end() )
+        {
+            it = records.insert( item, Record() );
+            it->name = qskItemName( item );
+        }
+
+        return it.value();
+    }
+
+    // the item, that is responsible for the work being done
+    Record* currentRecord()
+    {
+        return stack.isEmpty() ? nullptr : &record( stack.last() );
+    }
+
+    QHash< const QQuickItem*, Record > records;
+    QVector< const QQuickItem* > stack;
+
+    QElapsedTimer clock;
+
+    const bool debugAtDestruction;
+};
+
+QskLayoutProfiler::QskLayoutProfiler( bool debugAtDestruction )
+    : m_data( new PrivateData( debugAtDestruction ) )
+{
+    setActive( true );
+}
+
+QskLayoutProfiler::~QskLayoutProfiler()
+{
+    setActive( false );
+
+    if ( m_data->debugAtDestruction )
+        dump();
+}
+
+void QskLayoutProfiler::setActive( bool on )
+{
+    if ( on )
+    {
+        qskProfiler = this;
+    }
+    else
+    {
+        if ( qskProfiler == this )
+            qskProfiler = nullptr;
+    }
+
+    m_data->stack.clear();
+}
+
+bool QskLayoutProfiler::isActive() const
+{
+    return qskProfiler == this;
+}
+
+void QskLayoutProfiler::reset()
+{
+    m_data->records.clear();
+}
+
+QVector< QskLayoutProfiler::Record > QskLayoutProfiler::records() const
+{
+    QVector< Record > records;
+    records.reserve( m_data->records.count() );
+
+    for ( auto it = m_data->records.constBegin(); it != m_data->records.constEnd(); ++it )
+        records += it.value();
+
+    std::sort( records.begin(), records.end(),
+        []( const Record& r1, const Record& r2 )
+        {
+            if ( r1.layoutTime != r2.layoutTime )
+                return r1.layoutTime > r2.layoutTime;
+
+            return r1.sizeHintQueries > r2.sizeHintQueries;
+        } );
+
+    return records;
+}
+
+void QskLayoutProfiler::debugStatistics( QDebug debug, int maxCount ) const
+{
+    const auto records = this->records();
+
+    if ( maxCount < 0 || maxCount > records.count() )
+        maxCount = records.count();
+
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+    debug.noquote();
+
+    for ( int i = 0; i < maxCount; i++ )
+    {
+        const auto& r = records[i];
+
+        debug << "\n  " << r.name << ':'
+            << " layout: " << r.layoutTime / 1000.0 << "us"
+            << " (" << r.layoutCount << "x)"
+            << ", hints: " << r.sizeHintQueries
+            << ", metrics: " << r.layoutMetricsCalls
+            << ", chains: " << r.chainRebuilds
+            << ", geometries: " << r.geometryAssignments
+            << ", requests: " << r.layoutRequestsSent
+            << '/' << r.layoutRequestsReceived;
+
+        if ( r.feedbackLoops > 0 )
+            debug << ", feedback loops: " << r.feedbackLoops;
+    }
+}
+
+void QskLayoutProfiler::dump() const
+{
+    QDebug debug = qDebug();
+
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << "* Layout Profile";
+    debugStatistics( debug );
+}
+
+QskLayoutProfiler::Scope::Scope( const QQuickItem* item, Type type )
+    : m_item( nullptr )
+    , m_type( type )
+{
+    if ( qskProfiler == nullptr || item == nullptr )
+        return;
+
+    auto d = qskProfiler->m_data.get();
+
+    if ( type == SizeHint )
+        d->record( item ).sizeHintQueries++;
+    else
+        m_startTime = d->clock.nsecsElapsed();
+
+    d->stack += item;
+    m_item = item;
+}
+
+QskLayoutProfiler::Scope::~Scope()
+{
+    if ( m_item == nullptr || qskProfiler == nullptr )
+        return;
+
+    auto d = qskProfiler->m_data.get();
+
+    if ( d->stack.isEmpty() || d->stack.last() != m_item )
+        return; // the profiler has been reset in between
+
+    d->stack.removeLast();
+
+    if ( m_type == Layout && m_startTime >= 0 )
+    {
+        auto& record = d->record( m_item );
+
+        record.layoutCount++;
+        record.layoutTime += d->clock.nsecsElapsed() - m_startTime;
+    }
+}
+
+void QskLayoutProfiler::countLayoutMetrics()
+{
+    if ( qskProfiler )
+    {
+        if ( auto record = qskProfiler->m_data->currentRecord() )
+            record->layoutMetricsCalls++;
+    }
+}
+
+void QskLayoutProfiler::countChainRebuild()
+{
+    if ( qskProfiler )
+    {
+        if ( auto record = qskProfiler->m_data->currentRecord() )
+            record->chainRebuilds++;
+    }
+}
+
+void QskLayoutProfiler::countGeometryAssignment()
+{
+    if ( qskProfiler )
+    {
+        if ( auto record = qskProfiler->m_data->currentRecord() )
+            record->geometryAssignments++;
+    }
+}
+
+void QskLayoutProfiler::countLayoutRequest(
+    const QQuickItem* sender, const QQuickItem* receiver )
+{
+    if ( qskProfiler == nullptr || sender == nullptr || receiver == nullptr )
+        return;
+
+    auto d = qskProfiler->m_data.get();
+
+    d->record( sender ).layoutRequestsSent++;
+
+    auto& record = d->record( receiver );
+    record.layoutRequestsReceived++;
+
+    /*
+        The receiver is calculating hints or its layout right now
+        and the request is the result of it. Usually the engine ignores
+        these requests ( blockInvalidate ), but the hints, that have been
+        used might be outdated.
+     */
+    if ( d->stack.contains( receiver ) )
+        record.feedbackLoops++;
+}
+
+#ifndef QT_NO_DEBUG_STREAM
+
+QDebug operator<<( QDebug debug, const QskLayoutProfiler& profiler )
+{
+    profiler.debugStatistics( debug );
+    return debug;
+}
+
+#endif
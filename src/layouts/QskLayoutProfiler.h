@@ -0,0 +1,105 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_LAYOUT_PROFILER_H
+#define QSK_LAYOUT_PROFILER_H
+
+#include "QskGlobal.h"
+
+#include <qstring.h>
+#include <qvector.h>
+
+#include <memory>
+
+class QQuickItem;
+class QDebug;
+
+/*
+    Collecting per item statistics about size hint queries, layout
+    calculations and geometry assignments, while being active.
+
+    Work that is done inside of a hint query or updateLayout() of an item
+    is accounted to this item. A LayoutRequest, that is sent to an item,
+    that is in the middle of calculating hints or its layout, is counted
+    as a feedback loop.
+
+    Only one profiler can be active at a time.
+ */
+class QSK_EXPORT QskLayoutProfiler
+{
+  public:
+    class Record
+    {
+      public:
+        QString name;
+
+        quint64 sizeHintQueries = 0; // QskControl::effectiveSizeHint
+        quint64 layoutMetricsCalls = 0;
+        quint64 chainRebuilds = 0;
+        quint64 geometryAssignments = 0;
+
+        quint64 layoutRequestsSent = 0;
+        quint64 layoutRequestsReceived = 0;
+        quint64 feedbackLoops = 0;
+
+        quint64 layoutCount = 0; // calls of updateLayout
+        qint64 layoutTime = 0;   // nsecs spent in updateLayout
+    };
+
+    QskLayoutProfiler( bool debugAtDestruction = false );
+    ~QskLayoutProfiler();
+
+    void setActive( bool );
+    bool isActive() const;
+
+    void reset();
+
+    // sorted by layoutTime, then by sizeHintQueries
+    QVector< Record > records() const;
+
+    void debugStatistics( QDebug, int maxCount = -1 ) const;
+    void dump() const;
+
+    // hooks for the layout code
+
+    class Scope
+    {
+      public:
+        enum Type
+        {
+            SizeHint,
+            Layout
+        };
+
+        Scope( const QQuickItem*, Type );
+        ~Scope();
+
+      private:
+        Q_DISABLE_COPY( Scope )
+
+        const QQuickItem* m_item;
+        const Type m_type;
+        qint64 m_startTime = -1;
+    };
+
+    static void countLayoutMetrics();
+    static void countChainRebuild();
+    static void countGeometryAssignment();
+    static void countLayoutRequest( const QQuickItem* sender, const QQuickItem* receiver );
+
+  private:
+    Q_DISABLE_COPY( QskLayoutProfiler )
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#ifndef QT_NO_DEBUG_STREAM
+
+QSK_EXPORT QDebug operator<<( QDebug, const QskLayoutProfiler& );
+
+#endif
+
+#endif
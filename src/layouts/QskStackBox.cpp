@@ -8,16 +8,53 @@
 #include "QskEvent.h"
 #include "QskQuick.h"
 
+#include <QBasicTimer>
+#include <QElapsedTimer>
 #include <QPointer>
 
+#include <algorithm>
+
+namespace
+{
+    class Page
+    {
+      public:
+        QQuickItem* item = nullptr;
+
+        QskStackBox::ItemFactory factory;
+        Qt::Alignment alignment;
+
+        qint64 lastActive = 0; // ms
+        bool isReleased = false;
+    };
+}
+
 class QskStackBox::PrivateData
 {
   public:
-    QVector< QQuickItem* > items;
+    inline bool isTransitioning( int index ) const
+    {
+        return animator && animator->isRunning()
+            && ( index == animator->startIndex() || index == animator->endIndex() );
+    }
+
+    inline bool isLoaded( const Page& page ) const
+    {
+        return page.item && !page.isReleased;
+    }
+
+    QVector< Page > pages;
     QPointer< QskStackBoxAnimator > animator;
 
+    QElapsedTimer clock;
+    QBasicTimer unloadTimer;
+
     int currentIndex = -1;
     Qt::Alignment defaultAlignment = Qt::AlignLeft | Qt::AlignVCenter;
+
+    UnloadPolicy unloadPolicy = KeepItems;
+    int unloadTimeout = 0;
+    int unloadLimit = -1;
 };
 
 QskStackBox::QskStackBox( QQuickItem* parent )
@@ -30,6 +67,7 @@ QskStackBox::QskStackBox( bool autoAddChildren, QQuickItem* parent )
     , m_data( new PrivateData() )
 {
     setAutoAddChildren( autoAddChildren );
+    m_data->clock.start();
 }
 
 QskStackBox::~QskStackBox()
@@ -92,23 +130,78 @@ QskStackBoxAnimator* QskStackBox::effectiveAnimator()
     return nullptr;
 }
 
+void QskStackBox::setUnloadPolicy( UnloadPolicy policy )
+{
+    if ( policy != m_data->unloadPolicy )
+    {
+        m_data->unloadPolicy = policy;
+        scheduleUnloading();
+
+        Q_EMIT unloadPolicyChanged( policy );
+    }
+}
+
+QskStackBox::UnloadPolicy QskStackBox::unloadPolicy() const
+{
+    return m_data->unloadPolicy;
+}
+
+void QskStackBox::setUnloadTimeout( int ms )
+{
+    ms = qMax( ms, 0 );
+
+    if ( ms != m_data->unloadTimeout )
+    {
+        m_data->unloadTimeout = ms;
+        scheduleUnloading();
+
+        Q_EMIT unloadTimeoutChanged( ms );
+    }
+}
+
+int QskStackBox::unloadTimeout() const
+{
+    return m_data->unloadTimeout;
+}
+
+void QskStackBox::setUnloadLimit( int limit )
+{
+    limit = qMax( limit, -1 );
+
+    if ( limit != m_data->unloadLimit )
+    {
+        m_data->unloadLimit = limit;
+        scheduleUnloading();
+
+        Q_EMIT unloadLimitChanged( limit );
+    }
+}
+
+int QskStackBox::unloadLimit() const
+{
+    return m_data->unloadLimit;
+}
+
 int QskStackBox::itemCount() const
 {
-    return m_data->items.count();
+    return m_data->pages.count();
 }
 
 QQuickItem* QskStackBox::itemAtIndex( int index ) const
 {
-    return m_data->items.value( index );
+    if ( index >= 0 && index < m_data->pages.count() )
+        return m_data->pages[ index ].item;
+
+    return nullptr;
 }
 
 int QskStackBox::indexOf( const QQuickItem* item ) const
 {
     if ( item && ( item->parentItem() == this ) )
     {
-        for ( int i = 0; i < m_data->items.count(); i++ )
+        for ( int i = 0; i < m_data->pages.count(); i++ )
         {
-            if ( item == m_data->items[i] )
+            if ( item == m_data->pages[i].item )
                 return i;
         }
     }
@@ -116,6 +209,68 @@ int QskStackBox::indexOf( const QQuickItem* item ) const
     return -1;
 }
 
+bool QskStackBox::isInstantiated( int index ) const
+{
+    return itemAtIndex( index ) != nullptr;
+}
+
+int QskStackBox::instantiatedCount() const
+{
+    int count = 0;
+
+    for ( const auto& page : qAsConst( m_data->pages ) )
+    {
+        if ( page.item )
+            count++;
+    }
+
+    return count;
+}
+
+QQuickItem* QskStackBox::instantiateItemAt( int index )
+{
+    if ( index < 0 || index >= m_data->pages.count() )
+        return nullptr;
+
+    if ( m_data->pages[ index ].item || !m_data->pages[ index ].factory )
+        return m_data->pages[ index ].item;
+
+    // the factory is not expected to modify the box
+    auto item = m_data->pages[ index ].factory();
+    if ( item == nullptr || item == this )
+        return nullptr;
+
+    auto& page = m_data->pages[ index ];
+
+    item->setVisible( false );
+    reparentItem( item );
+
+    if ( page.alignment )
+    {
+        if ( auto control = qskControlCast( item ) )
+            control->setLayoutAlignmentHint( page.alignment );
+    }
+
+    if ( !qskPlacementPolicy( item ).isEffective() )
+    {
+        qWarning() << "Creating an item that is to be ignored for layouting"
+            << item->metaObject()->className();
+
+        qskSetPlacementPolicy( item, QskPlacementPolicy() );
+    }
+
+    page.item = item;
+    page.isReleased = false;
+    page.lastActive = m_data->clock.elapsed();
+
+    resetImplicitSize();
+    polish();
+
+    scheduleUnloading();
+
+    return item;
+}
+
 QQuickItem* QskStackBox::currentItem() const
 {
     return itemAtIndex( m_data->currentIndex );
@@ -142,6 +297,9 @@ void QskStackBox::setCurrentIndex( int index )
     if ( animator )
         animator->stop();
 
+    // the item has to exist before starting the transition
+    instantiateItemAt( index );
+
     if ( window() && isVisible() && isInitiallyPainted() && animator )
     {
         // start the animation
@@ -162,9 +320,17 @@ void QskStackBox::setCurrentIndex( int index )
             item2->setVisible( true );
     }
 
+    if ( m_data->currentIndex >= 0 )
+        m_data->pages[ m_data->currentIndex ].lastActive = m_data->clock.elapsed();
+
+    if ( index >= 0 )
+        m_data->pages[ index ].isReleased = false;
+
     m_data->currentIndex = index;
     polish();
 
+    scheduleUnloading();
+
     Q_EMIT currentIndexChanged( m_data->currentIndex );
 }
 
@@ -224,25 +390,79 @@ void QskStackBox::insertItem( int index, QQuickItem* item )
                 return;
             }
 
-            m_data->items.removeAt( oldIndex );
+            m_data->pages.removeAt( oldIndex );
         }
     }
 
     if ( doAppend )
         index = itemCount();
 
-    m_data->items.insert( index, item );
+    Page page;
+    page.item = item;
+    page.lastActive = m_data->clock.elapsed();
+
+    m_data->pages.insert( index, page );
+
+    itemInserted( index );
+}
+
+void QskStackBox::insertItem(
+    int index, QQuickItem* item, Qt::Alignment alignment )
+{
+    if ( auto control = qskControlCast( item ) )
+        control->setLayoutAlignmentHint( alignment );
+
+    insertItem( index, item );
+}
+
+void QskStackBox::addItem( const ItemFactory& factory )
+{
+    insertItem( -1, factory );
+}
+
+void QskStackBox::addItem( const ItemFactory& factory, Qt::Alignment alignment )
+{
+    insertItem( -1, factory, alignment );
+}
+
+void QskStackBox::insertItem( int index, const ItemFactory& factory )
+{
+    insertItem( index, factory, Qt::Alignment() );
+}
+
+void QskStackBox::insertItem(
+    int index, const ItemFactory& factory, Qt::Alignment alignment )
+{
+    if ( !factory )
+        return;
+
+    if ( ( index < 0 ) || ( index >= itemCount() ) )
+        index = itemCount();
+
+    Page page;
+    page.factory = factory;
+    page.alignment = alignment;
+
+    m_data->pages.insert( index, page );
+
+    itemInserted( index );
+}
 
+void QskStackBox::itemInserted( int index )
+{
     const int oldCurrentIndex = m_data->currentIndex;
 
-    if ( m_data->items.count() == 1 )
+    if ( m_data->pages.count() == 1 )
     {
         m_data->currentIndex = 0;
-        item->setVisible( true );
+
+        if ( auto item = instantiateItemAt( 0 ) )
+            item->setVisible( true );
     }
     else
     {
-        item->setVisible( false );
+        if ( auto item = m_data->pages[ index ].item )
+            item->setVisible( false );
 
         if ( index <= m_data->currentIndex )
             m_data->currentIndex++;
@@ -255,15 +475,6 @@ void QskStackBox::insertItem( int index, QQuickItem* item )
     polish();
 }
 
-void QskStackBox::insertItem(
-    int index, QQuickItem* item, Qt::Alignment alignment )
-{
-    if ( auto control = qskControlCast( item ) )
-        control->setLayoutAlignmentHint( alignment );
-
-    insertItem( index, item );
-}
-
 void QskStackBox::removeAt( int index )
 {
     removeItemInternal( index, true );
@@ -271,28 +482,36 @@ void QskStackBox::removeAt( int index )
 
 void QskStackBox::removeItemInternal( int index, bool unparent )
 {
-    if ( index < 0 || index >= m_data->items.count() )
+    if ( index < 0 || index >= m_data->pages.count() )
         return;
 
-    if ( unparent )
+    const auto page = m_data->pages.takeAt( index );
+
+    if ( unparent && page.item )
     {
-        if ( auto item = m_data->items[ index ] )
-            unparentItem( item );
+        // items created by a factory are owned by the box
+        if ( page.factory )
+            delete page.item;
+        else
+            unparentItem( page.item );
     }
 
-    m_data->items.removeAt( index );
-
     auto& currentIndex = m_data->currentIndex;
 
     if ( index <= currentIndex )
     {
         currentIndex--;
 
-        if ( currentIndex < 0 && !m_data->items.isEmpty() )
+        if ( currentIndex < 0 && !m_data->pages.isEmpty() )
             currentIndex = 0;
 
         if ( currentIndex >= 0 )
-            m_data->items[ currentIndex ]->setVisible( true );
+        {
+            m_data->pages[ currentIndex ].isReleased = false;
+
+            if ( auto item = instantiateItemAt( currentIndex ) )
+                item->setVisible( true );
+        }
 
         Q_EMIT currentIndexChanged( currentIndex );
     }
@@ -318,15 +537,22 @@ void QskStackBox::autoRemoveItem( QQuickItem* item )
 
 void QskStackBox::clear( bool autoDelete )
 {
-    for ( const auto item : qAsConst( m_data->items ) )
+    // deleting items might end up in autoRemoveItem
+    const auto pages = m_data->pages;
+    m_data->pages.clear();
+
+    for ( const auto& page : pages )
     {
-        if( autoDelete && ( item->parent() == this ) )
-            delete item;
-        else
-            item->setParentItem( nullptr );
+        if ( auto item = page.item )
+        {
+            if( page.factory || ( autoDelete && ( item->parent() == this ) ) )
+                delete item;
+            else
+                item->setParentItem( nullptr );
+        }
     }
 
-    m_data->items.clear();
+    m_data->unloadTimer.stop();
 
     if ( m_data->currentIndex >= 0 )
     {
@@ -339,7 +565,7 @@ QRectF QskStackBox::geometryForItemAt( int index ) const
 {
     const auto r = layoutRect();
 
-    if ( const auto item = m_data->items.value( index ) )
+    if ( const auto item = itemAtIndex( index ) )
     {
         auto alignment = qskLayoutAlignmentHint( item );
         if ( alignment == 0 )
@@ -356,9 +582,11 @@ void QskStackBox::updateLayout()
     if ( maybeUnresized() )
         return;
 
-    for ( int i = 0; i < m_data->items.count(); i++ )
+    for ( int i = 0; i < m_data->pages.count(); i++ )
     {
-        auto item = m_data->items[ i ];
+        auto item = m_data->pages[ i ].item;
+        if ( item == nullptr )
+            continue;
 
         const auto visibility =
             ( i == m_data->currentIndex ) ? Qsk::Visible : Qsk::Hidden;
@@ -366,7 +594,7 @@ void QskStackBox::updateLayout()
         if ( qskPlacementPolicy( item ).isAdjusting( visibility ) )
         {
             const auto rect = geometryForItemAt( i );
-            qskSetItemGeometry( m_data->items[ i ], rect );
+            qskSetItemGeometry( item, rect );
         }
     }
 }
@@ -380,12 +608,18 @@ QSizeF QskStackBox::layoutSizeHint(
     qreal w = -1.0;
     qreal h = -1.0;
 
-    for ( const auto item : qAsConst( m_data->items ) )
+    for ( const auto& page : qAsConst( m_data->pages ) )
     {
         /*
             We ignore the retainSizeWhenVisible flag and include all
             invisible items. Maybe we should offer a flag to control this ?
+
+            Items, that have not been created yet, can't be considered.
          */
+        const auto item = page.item;
+        if ( item == nullptr )
+            continue;
+
         const auto policy = qskSizePolicy( item );
 
         if ( constraint.width() >= 0.0 && policy.isConstrained( Qt::Vertical ) )
@@ -432,6 +666,109 @@ bool QskStackBox::event( QEvent* event )
     return Inherited::event( event );
 }
 
+void QskStackBox::timerEvent( QTimerEvent* event )
+{
+    if ( event->timerId() == m_data->unloadTimer.timerId() )
+    {
+        m_data->unloadTimer.stop();
+        unloadItems();
+
+        return;
+    }
+
+    Inherited::timerEvent( event );
+}
+
+void QskStackBox::scheduleUnloading()
+{
+    /*
+        Unloading is never done synchronously as we might be
+        called from a signal sent by one of the items
+     */
+    if ( m_data->unloadPolicy != KeepItems )
+        m_data->unloadTimer.start( 0, this );
+}
+
+void QskStackBox::unloadItems()
+{
+    if ( m_data->unloadPolicy == KeepItems )
+        return;
+
+    auto& pages = m_data->pages;
+
+    QVector< int > candidates;
+    for ( int i = 0; i < pages.count(); i++ )
+    {
+        if ( i != m_data->currentIndex && m_data->isLoaded( pages[i] ) )
+            candidates += i;
+    }
+
+    // least recently used first
+    std::sort( candidates.begin(), candidates.end(),
+        [ &pages ]( int i1, int i2 )
+        { return pages[ i1 ].lastActive < pages[ i2 ].lastActive; } );
+
+    int excess = 0;
+    if ( m_data->unloadLimit >= 0 )
+        excess = candidates.count() - m_data->unloadLimit;
+
+    const auto timeout = m_data->unloadTimeout;
+    const auto now = m_data->clock.elapsed();
+
+    qint64 nextCheck = -1;
+
+    for ( const auto index : qAsConst( candidates ) )
+    {
+        auto& page = pages[ index ];
+
+        const bool isExpired = ( timeout > 0 ) && ( now - page.lastActive >= timeout );
+
+        if ( !( isExpired || excess > 0 ) )
+        {
+            if ( timeout > 0 )
+            {
+                const auto remaining = page.lastActive + timeout - now;
+                if ( nextCheck < 0 || remaining < nextCheck )
+                    nextCheck = remaining;
+            }
+
+            continue;
+        }
+
+        if ( m_data->isTransitioning( index ) )
+        {
+            // trying again, when the transition is completed
+            const auto animator = m_data->animator;
+
+            const auto remaining = qMax(
+                animator->duration() - animator->elapsed(), qint64( 1 ) );
+            if ( nextCheck < 0 || remaining < nextCheck )
+                nextCheck = remaining;
+
+            continue;
+        }
+
+        if ( m_data->unloadPolicy == DeleteItems && page.factory )
+        {
+            // resetting the page first, so that autoRemoveItem ignores it
+            auto item = page.item;
+            page.item = nullptr;
+
+            delete item;
+        }
+        else
+        {
+            qskReleaseNodesRecursive( page.item );
+            page.isReleased = true;
+        }
+
+        excess--;
+    }
+
+    if ( nextCheck >= 0 )
+        m_data->unloadTimer.start( int( qMax( nextCheck, qint64( 1 ) ) ), this );
+}
+
 void QskStackBox::dump() const
 {
     auto debug = qDebug();
@@ -444,15 +781,22 @@ void QskStackBox::dump() const
     debug << "QskStackBox"
           << " w:" << constraint.width() << " h:" << constraint.height() << '\n';
 
-    for ( int i = 0; i < m_data->items.count(); i++ )
+    for ( int i = 0; i < m_data->pages.count(); i++ )
     {
-        const auto item = m_data->items[i];
+        const auto item = m_data->pages[i].item;
 
         debug << "  " << i << ": ";
 
-        const auto constraint = qskSizeConstraint( item, Qt::PreferredSize );
-        debug << item->metaObject()->className()
-              << " w:" << constraint.width() << " h:" << constraint.height();
+        if ( item )
+        {
+            const auto constraint = qskSizeConstraint( item, Qt::PreferredSize );
+            debug << item->metaObject()->className()
+                  << " w:" << constraint.width() << " h:" << constraint.height();
+        }
+        else
+        {
+            debug << "-";
+        }
 
         if ( i == m_data->currentIndex )
             debug << " [X]";
@@ -7,9 +7,20 @@
 #define QSK_STACK_BOX_H
 
 #include "QskIndexedLayoutBox.h"
+#include <functional>
 
 class QskStackBoxAnimator;
 
+/*
+    Items can also be added as factories, that are called, when the item
+    becomes the current item for the first time. Then the box takes
+    ownership of the created item.
+
+    Items that are not current might be unloaded according to the
+    unloadPolicy(), when they have not been current for unloadTimeout()
+    milliseconds, or when there are more than unloadLimit() of them
+    holding resources. Items in a running transition are never unloaded.
+ */
 class QSK_EXPORT QskStackBox : public QskIndexedLayoutBox
 {
     Q_OBJECT
@@ -23,9 +34,32 @@ class QSK_EXPORT QskStackBox : public QskIndexedLayoutBox
     Q_PROPERTY( QQuickItem* currentItem READ currentItem
         WRITE setCurrentItem NOTIFY currentItemChanged )
 
+    Q_PROPERTY( UnloadPolicy unloadPolicy READ unloadPolicy
+        WRITE setUnloadPolicy NOTIFY unloadPolicyChanged )
+
+    Q_PROPERTY( int unloadTimeout READ unloadTimeout
+        WRITE setUnloadTimeout NOTIFY unloadTimeoutChanged )
+
+    Q_PROPERTY( int unloadLimit READ unloadLimit
+        WRITE setUnloadLimit NOTIFY unloadLimitChanged )
+
     using Inherited = QskBox;
 
   public:
+    using ItemFactory = std::function< QQuickItem*() >;
+
+    enum UnloadPolicy
+    {
+        KeepItems,
+
+        // releasing the scene graph nodes, see qskReleaseNodesRecursive
+        ReleaseNodes,
+
+        // deleting items created by a factory, releasing nodes of all others
+        DeleteItems
+    };
+    Q_ENUM( UnloadPolicy )
+
     explicit QskStackBox( QQuickItem* parent = nullptr );
     QskStackBox( bool autoAddChildren, QQuickItem* parent = nullptr );
 
@@ -43,6 +77,17 @@ class QSK_EXPORT QskStackBox : public QskIndexedLayoutBox
     void insertItem( int index, QQuickItem* );
     void insertItem( int index, QQuickItem*, Qt::Alignment );
 
+    void addItem( const ItemFactory& );
+    void addItem( const ItemFactory&, Qt::Alignment );
+
+    void insertItem( int index, const ItemFactory& );
+    void insertItem( int index, const ItemFactory&, Qt::Alignment );
+
+    // itemAtIndex() returns nullptr for items, that have not been created yet
+    bool isInstantiated( int index ) const;
+    QQuickItem* instantiateItemAt( int index );
+    int instantiatedCount() const;
+
     void removeItem( const QQuickItem* );
     void removeAt( int index );
 
@@ -58,6 +103,17 @@ class QSK_EXPORT QskStackBox : public QskIndexedLayoutBox
     const QskStackBoxAnimator* animator() const;
     QskStackBoxAnimator* animator();
 
+    void setUnloadPolicy( UnloadPolicy );
+    UnloadPolicy unloadPolicy() const;
+
+    // in ms, 0: no unloading because of inactivity
+    void setUnloadTimeout( int );
+    int unloadTimeout() const;
+
+    // -1: no limit
+    void setUnloadLimit( int );
+    int unloadLimit() const;
+
     QRectF geometryForItemAt( int index ) const;
 
     void dump() const;
@@ -75,8 +131,13 @@ class QSK_EXPORT QskStackBox : public QskIndexedLayoutBox
     void transientIndexChanged( qreal index );
     void currentItemChanged( QQuickItem* );
 
+    void unloadPolicyChanged( UnloadPolicy );
+    void unloadTimeoutChanged( int );
+    void unloadLimitChanged( int );
+
   protected:
     bool event( QEvent* ) override;
+    void timerEvent( QTimerEvent* ) override;
     void updateLayout() override;
 
     QSizeF layoutSizeHint( Qt::SizeHint, const QSizeF& ) const override;
@@ -88,6 +149,10 @@ class QSK_EXPORT QskStackBox : public QskIndexedLayoutBox
     void autoRemoveItem( QQuickItem* ) override final;
 
     void removeItemInternal( int index, bool unparent );
+    void itemInserted( int index );
+
+    void scheduleUnloading();
+    void unloadItems();
 
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
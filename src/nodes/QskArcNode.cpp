@@ -4,10 +4,42 @@
  *****************************************************************************/
 
 #include "QskArcNode.h"
+#include "QskArcMetrics.h"
 #include "QskArcRenderer.h"
+#include "QskGradient.h"
+
+#include <qglobalstatic.h>
+#include <qquickwindow.h>
+#include <qsgvertexcolormaterial.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qsgnode_p.h>
+QSK_QT_PRIVATE_END
+
+Q_GLOBAL_STATIC( QSGVertexColorMaterial, qskMaterialVertex )
+
+class QskArcNodePrivate final : public QSGGeometryNodePrivate
+{
+  public:
+    QskArcNodePrivate()
+        : geometry( QSGGeometry::defaultAttributes_ColoredPoint2D(), 0 )
+    {
+    }
+
+    QSGGeometry geometry;
+
+    QRectF rect;
+    qreal devicePixelRatio = 1.0;
+    QskHashValue hash = 0;
+};
 
 QskArcNode::QskArcNode()
+    : QSGGeometryNode( *new QskArcNodePrivate )
 {
+    Q_D( QskArcNode );
+
+    setGeometry( &d->geometry );
+    setMaterial( qskMaterialVertex );
 }
 
 QskArcNode::~QskArcNode()
@@ -17,27 +49,31 @@ QskArcNode::~QskArcNode()
 void QskArcNode::setArcData( const QRectF& rect, const QskArcMetrics& metrics,
     const QskGradient& gradient, QQuickWindow* window )
 {
-    m_metrics = metrics;
-    m_gradient = gradient;
+    Q_D( QskArcNode );
 
-    update( window, QskTextureRenderer::AutoDetect, rect.toRect() );
-}
+    auto hash = metrics.hash( 13000 );
+    hash = gradient.hash( hash );
 
-void QskArcNode::paint( QPainter* painter, const QSizeF& size )
-{
-    const qreal w = m_metrics.width();
-    const QRectF rect( 0.5 * w, 0.5 * w, size.width() - w, size.height() - w );
+    // the antialiasing fringe depends on the device pixel ratio
+    const qreal ratio = window ? window->effectiveDevicePixelRatio() : 1.0;
 
-    QskArcRenderer renderer;
-    renderer.renderArc( rect, m_metrics, m_gradient, painter );
-}
+    if ( ( hash == d->hash ) && ( rect == d->rect ) && ( ratio == d->devicePixelRatio ) )
+        return;
 
-QskHashValue QskArcNode::hash() const
-{
-    auto h = m_metrics.hash();
+    d->hash = hash;
+    d->rect = rect;
+    d->devicePixelRatio = ratio;
+
+    /*
+        The material is shared between all nodes and doesn't depend
+        on the colors, so we only have to update the vertices.
+     */
 
-    for( const auto& stop : qAsConst( m_gradient.stops() ) )
-        h = stop.hash( h );
+    const qreal w = metrics.width();
+    const QRectF r = rect.adjusted( 0.5 * w, 0.5 * w, -0.5 * w, -0.5 * w );
+
+    QskArcRenderer renderer;
+    renderer.renderArc( r, metrics, gradient, ratio, d->geometry );
 
-    return h;
+    markDirty( QSGNode::DirtyGeometry );
 }
@@ -6,11 +6,19 @@
 #ifndef QSK_ARC_NODE_H
 #define QSK_ARC_NODE_H
 
-#include "QskArcMetrics.h"
-#include "QskGradient.h"
-#include "QskPaintedNode.h"
+#include "QskGlobal.h"
 
-class QSK_EXPORT QskArcNode : public QskPaintedNode
+#include <qsgnode.h>
+
+class QskArcMetrics;
+class QskGradient;
+
+class QQuickWindow;
+class QRectF;
+
+class QskArcNodePrivate;
+
+class QSK_EXPORT QskArcNode : public QSGGeometryNode
 {
   public:
     QskArcNode();
@@ -19,12 +27,8 @@ class QSK_EXPORT QskArcNode : public QskPaintedNode
     void setArcData( const QRectF&, const QskArcMetrics&,
         const QskGradient&, QQuickWindow* );
 
-    void paint( QPainter* painter, const QSizeF& size ) override;
-    QskHashValue hash() const override;
-
   private:
-    QskArcMetrics m_metrics;
-    QskGradient m_gradient;
+    Q_DECLARE_PRIVATE( QskArcNode )
 };
 
 #endif
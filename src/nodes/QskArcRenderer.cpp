@@ -6,11 +6,255 @@
 #include "QskArcRenderer.h"
 #include "QskArcMetrics.h"
 #include "QskGradient.h"
+#include "QskVertex.h"
 
+#include <qmath.h>
 #include <qpainter.h>
 #include <qrect.h>
+#include <qsggeometry.h>
+#include <qvector.h>
 
-void QskArcRenderer::renderArc(const QRectF& rect,
+#include <algorithm>
+
+static inline int qskStepCount( qreal radius, qreal spanAngle )
+{
+    /*
+        The deviation of a chord from the ideal curve is ~ radius * step² / 8.
+        We want to stay below 1/4 of a pixel.
+     */
+    const qreal step = qMin< qreal >( M_PI / 8.0, qSqrt( 2.0 / qMax< qreal >( radius, 1.0 ) ) );
+    return qMax( 1, qCeil( qDegreesToRadians( qAbs( spanAngle ) ) / step ) );
+}
+
+static inline QColor qskColorAt(
+    const QVector< QskGradientStop >& stops, qreal position )
+{
+    if ( stops.isEmpty() )
+        return QColor();
+
+    if ( position <= stops.first().position() )
+        return stops.first().color();
+
+    for ( int i = 1; i < stops.count(); i++ )
+    {
+        if ( position <= stops[ i ].position() )
+            return QskGradientStop::interpolated( stops[ i - 1 ], stops[ i ], position );
+    }
+
+    return stops.last().color();
+}
+
+namespace
+{
+    class Sample
+    {
+      public:
+        qreal value; // offset or angle
+        qreal alpha; // 0.0 for the antialiasing fringe
+    };
+
+    class ArcStroker
+    {
+      public:
+        ArcStroker( const QRectF& rect, const QskArcMetrics& metrics,
+                const QskGradient& gradient, qreal fringe )
+            : m_center( rect.center() )
+            , m_rx( 0.5 * rect.width() )
+            , m_ry( 0.5 * rect.height() )
+            , m_startAngle( metrics.startAngle() )
+            , m_spanAngle( qBound< qreal >( -360.0, metrics.spanAngle(), 360.0 ) )
+            , m_isRadial( gradient.orientation() == QskGradient::Vertical )
+            , m_stops( gradient.stops() )
+        {
+            // the same radius, that is used for the QRadialGradient
+            m_radialRadius = qMin( rect.width(), rect.height() );
+
+            const qreal w2 = 0.5 * metrics.width();
+
+            /*
+                Without multisampling the edges of the triangles are aliased.
+                So the borders are made of a fringe of 2 * fringe, where the
+                alpha fades out - centered at the ideal border line.
+             */
+
+            m_offsets += Sample { -w2 - fringe, 0.0 };
+
+            if ( w2 > fringe )
+            {
+                m_offsets += Sample { -w2 + fringe, 1.0 };
+
+                if ( m_isRadial )
+                {
+                    /*
+                        Additional rings for the stops, so that the color
+                        interpolation between the vertices is correct. For
+                        ellipses this is an approximation.
+                     */
+                    const qreal r = qMin( m_rx, m_ry );
+
+                    for ( const auto& stop : m_stops )
+                    {
+                        const qreal offset = stop.position() * m_radialRadius - r;
+                        if ( offset > -w2 + fringe && offset < w2 - fringe )
+                            m_offsets += Sample { offset, 1.0 };
+                    }
+                }
+
+                m_offsets += Sample { w2 - fringe, 1.0 };
+            }
+            else
+            {
+                // arcs thinner than the fringe
+                m_offsets += Sample { 0.0, ( fringe > 0.0 ) ? w2 / fringe : 1.0 };
+            }
+
+            m_offsets += Sample { w2 + fringe, 0.0 };
+
+            const int stepCount = qskStepCount( qMax( m_rx, m_ry ) + w2, m_spanAngle );
+
+            for ( int i = 0; i <= stepCount; i++ )
+                m_angles += Sample { m_startAngle + i * m_spanAngle / stepCount, 1.0 };
+
+            const qreal direction = ( m_spanAngle >= 0.0 ) ? 1.0 : -1.0;
+
+            if ( qAbs( m_spanAngle ) < 360.0 )
+            {
+                // fringes for the flat caps
+
+                const qreal r = qMax( qMin( m_rx, m_ry ) - w2, 1.0 );
+                const qreal da = direction * qRadiansToDegrees( fringe / r );
+
+                if ( qAbs( da ) > 0.0 && 4.0 * qAbs( da ) < qAbs( m_spanAngle ) )
+                {
+                    const qreal endAngle = m_startAngle + m_spanAngle;
+
+                    m_angles.first() = { m_startAngle + da, 1.0 };
+                    m_angles.last() = { endAngle - da, 1.0 };
+
+                    m_angles += Sample { m_startAngle - da, 0.0 };
+                    m_angles += Sample { endAngle + da, 0.0 };
+                }
+            }
+
+            if ( !m_isRadial )
+            {
+                // additional vertices at the positions of the stops
+
+                for ( const auto& stop : m_stops )
+                {
+                    const qreal angle = ( m_spanAngle >= 0.0 )
+                        ? stop.position() * 360.0 : ( stop.position() - 1.0 ) * 360.0;
+
+                    if ( qAbs( angle ) > 0.0 && qAbs( angle ) < qAbs( m_spanAngle ) )
+                        m_angles += Sample { m_startAngle + angle, 1.0 };
+                }
+            }
+
+            const auto startAngle = m_startAngle;
+
+            std::sort( m_angles.begin(), m_angles.end(),
+                [ startAngle, direction ]( const Sample& s1, const Sample& s2 )
+                {
+                    return direction * ( s1.value - startAngle )
+                        < direction * ( s2.value - startAngle );
+                } );
+        }
+
+        int lineCount() const
+        {
+            return ( m_offsets.count() - 1 ) * m_angles.count();
+        }
+
+        void setLines( QskVertex::ColoredLine* lines ) const
+        {
+            const int angleCount = m_angles.count();
+
+            auto l = lines;
+
+            for ( int i = 1; i < m_offsets.count(); i++ )
+            {
+                /*
+                    The rings are connected in zigzag, so that the
+                    connecting triangles are degenerated.
+                 */
+                const bool forward = ( i % 2 ) == 1;
+
+                const auto& o1 = m_offsets[ i ];
+                const auto& o2 = m_offsets[ i - 1 ];
+
+                for ( int j = 0; j < angleCount; j++ )
+                {
+                    const auto& a = m_angles[ forward ? j : angleCount - 1 - j ];
+
+                    const auto p1 = point( a.value, o1.value );
+                    const auto p2 = point( a.value, o2.value );
+
+                    l->setLine( p1.x(), p1.y(), color( a.value, p1, a.alpha * o1.alpha ),
+                        p2.x(), p2.y(), color( a.value, p2, a.alpha * o2.alpha ) );
+
+                    l++;
+                }
+            }
+        }
+
+      private:
+        inline QPointF point( qreal angle, qreal offset ) const
+        {
+            const qreal radians = qDegreesToRadians( angle );
+
+            return QPointF( m_center.x() + ( m_rx + offset ) * qCos( radians ),
+                m_center.y() - ( m_ry + offset ) * qSin( radians ) );
+        }
+
+        inline QskVertex::Color color(
+            qreal angle, const QPointF& pos, qreal alpha ) const
+        {
+            if ( alpha <= 0.0 )
+                return QskVertex::Color( 0, 0, 0, 0 );
+
+            qreal position;
+
+            if ( m_isRadial )
+            {
+                const auto d = pos - m_center;
+                position = qSqrt( d.x() * d.x() + d.y() * d.y() ) / m_radialRadius;
+            }
+            else
+            {
+                // like QConicalGradient, starting at the start angle
+
+                position = ( angle - m_startAngle ) / 360.0;
+                if ( m_spanAngle < 0.0 )
+                    position += 1.0;
+            }
+
+            const QskVertex::Color c = qskColorAt( m_stops, position );
+
+            if ( alpha >= 1.0 )
+                return c;
+
+            // the colors are premultiplied
+            return c.interpolatedTo( QskVertex::Color( 0, 0, 0, 0 ), 1.0 - alpha );
+        }
+
+        const QPointF m_center;
+        const qreal m_rx;
+        const qreal m_ry;
+
+        const qreal m_startAngle;
+        const qreal m_spanAngle;
+
+        const bool m_isRadial;
+        qreal m_radialRadius;
+
+        const QVector< QskGradientStop > m_stops;
+
+        QVector< Sample > m_offsets; // from the center line
+        QVector< Sample > m_angles;
+    };
+}
+
+void QskArcRenderer::renderArc( const QRectF& rect,
     const QskArcMetrics& metrics, const QskGradient& gradient,
     QPainter* painter )
 {
@@ -51,3 +295,26 @@ void QskArcRenderer::renderArc(const QRectF& rect,
 
     painter->drawArc( rect, startAngle, spanAngle );
 }
+
+void QskArcRenderer::renderArc( const QRectF& rect,
+    const QskArcMetrics& metrics, const QskGradient& gradient,
+    qreal devicePixelRatio, QSGGeometry& geometry )
+{
+    geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
+
+    if ( rect.isEmpty() || metrics.isNull() || !gradient.isVisible() )
+    {
+        geometry.allocate( 0 );
+        return;
+    }
+
+    // half of a device pixel to each side of the border lines
+    const qreal fringe = 0.5 / qMax( devicePixelRatio, qreal( 0.1 ) );
+
+    const ArcStroker stroker( rect, metrics, gradient, fringe );
+
+    const auto lines = QskVertex::allocateLines< QskVertex::ColoredLine >(
+        geometry, stroker.lineCount() );
+
+    stroker.setLines( lines );
+}
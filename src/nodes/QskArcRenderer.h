@@ -13,12 +13,27 @@ class QskGradient;
 
 class QPainter;
 class QRectF;
+class QSGGeometry;
 
+/*
+    The rect is the bounding rectangle of the center line of the arc,
+    the width of the arc extends to both sides.
+
+    Gradients with a horizontal orientation are conical in direction
+    of the arc, while vertical means radial from the inner to the outer border
+ */
 class QSK_EXPORT QskArcRenderer
 {
   public:
     void renderArc( const QRectF&, const QskArcMetrics&,
         const QskGradient&, QPainter* );
+
+    /*
+        Triangle strip with vertex colors. The borders are antialiased
+        by a fringe of one device pixel, where the alpha fades out.
+     */
+    void renderArc( const QRectF&, const QskArcMetrics&,
+        const QskGradient&, qreal devicePixelRatio, QSGGeometry& );
 };
 
 #endif
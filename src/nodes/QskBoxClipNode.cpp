@@ -9,6 +9,12 @@
 #include "QskBoxShapeMetrics.h"
 #include "QskFunctions.h"
 
+#include <qatomic.h>
+
+static QAtomicInt qskScissorClips;
+static QAtomicInt qskStencilClips;
+static QAtomicInteger< quint64 > qskAvoidedStencilClips;
+
 static inline QskHashValue qskMetricsHash(
     const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& border )
 {
@@ -18,8 +24,53 @@ static inline QskHashValue qskMetricsHash(
     return border.hash( hash );
 }
 
+static inline bool qskIntersectsCorners( const QRectF& rect,
+    const QskBoxShapeMetrics& shape, const QRectF& contentsRect )
+{
+    const Qt::Corner corners[] =
+        { Qt::TopLeftCorner, Qt::TopRightCorner, Qt::BottomLeftCorner, Qt::BottomRightCorner };
+
+    for ( const auto corner : corners )
+    {
+        const auto radius = shape.radius( corner );
+        if ( radius.width() <= 0.0 || radius.height() <= 0.0 )
+            continue;
+
+        /*
+            The rounded corner of the clip region - also the inner one,
+            when having a border - is always inside of this square
+         */
+        QRectF cornerRect( QPointF(), radius );
+
+        switch ( corner )
+        {
+            case Qt::TopLeftCorner:
+                cornerRect.moveTopLeft( rect.topLeft() );
+                break;
+
+            case Qt::TopRightCorner:
+                cornerRect.moveTopRight( rect.topRight() );
+                break;
+
+            case Qt::BottomLeftCorner:
+                cornerRect.moveBottomLeft( rect.bottomLeft() );
+                break;
+
+            case Qt::BottomRightCorner:
+                cornerRect.moveBottomRight( rect.bottomRight() );
+                break;
+        }
+
+        if ( cornerRect.intersects( contentsRect ) )
+            return true;
+    }
+
+    return false;
+}
+
 QskBoxClipNode::QskBoxClipNode()
     : m_hash( 0 )
+    , m_mode( NoClip )
     , m_geometry( QSGGeometry::defaultAttributes_Point2D(), 0 )
 {
     setGeometry( &m_geometry );
@@ -27,23 +78,42 @@ QskBoxClipNode::QskBoxClipNode()
 
 QskBoxClipNode::~QskBoxClipNode()
 {
+    setClipMode( NoClip );
 }
 
 void QskBoxClipNode::setBox( const QRectF& rect,
     const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& border )
 {
+    setBox( rect, shape, border, QRectF() );
+}
+
+void QskBoxClipNode::setBox( const QRectF& rect, const QskBoxShapeMetrics& shape,
+    const QskBoxBorderMetrics& border, const QRectF& contentsRect )
+{
+    /*
+        Even when the content is inside of the clip region we can't
+        get rid of the node here. It is up to the skinlet to decide
+        about not having a clip node at all.
+     */
+    auto mode = clipMode( rect, shape, border, contentsRect );
+    if ( mode == NoClip )
+        mode = ScissorClip;
+
     const auto hash = qskMetricsHash( shape, border );
-    if ( hash == m_hash && rect == m_rect )
+    if ( hash == m_hash && rect == m_rect && mode == m_mode )
         return;
 
     m_rect = rect;
     m_hash = hash;
 
-    if ( shape.isRectangle() )
+    if ( mode == ScissorClip )
     {
         if ( m_geometry.vertexCount() > 0 )
             m_geometry.allocate( 0 );
 
+        if ( m_mode != ScissorClip && !shape.isRectangle() )
+            qskAvoidedStencilClips.fetchAndAddRelaxed( 1 );
+
         setIsRectangular( true );
     }
     else
@@ -52,6 +122,8 @@ void QskBoxClipNode::setBox( const QRectF& rect,
         QskBoxRenderer().renderFill( rect, shape, border, m_geometry );
     }
 
+    setClipMode( mode );
+
     /*
         Even in situations, where the clipping is not rectangular, it is
         useful to know its bounding rectangle
@@ -60,3 +132,70 @@ void QskBoxClipNode::setBox( const QRectF& rect,
 
     markDirty( QSGNode::DirtyGeometry );
 }
+
+void QskBoxClipNode::setRect( const QRectF& rect )
+{
+    // a hash of 0 indicates a clip without shape
+    if ( m_hash == 0 && rect == m_rect && m_mode == ScissorClip )
+        return;
+
+    m_rect = rect;
+    m_hash = 0;
+
+    if ( m_geometry.vertexCount() > 0 )
+        m_geometry.allocate( 0 );
+
+    setIsRectangular( true );
+    setClipMode( ScissorClip );
+    setClipRect( rect );
+
+    markDirty( QSGNode::DirtyGeometry );
+}
+
+QskBoxClipNode::ClipMode QskBoxClipNode::clipMode() const
+{
+    return m_mode;
+}
+
+QskBoxClipNode::ClipMode QskBoxClipNode::clipMode( const QRectF& rect,
+    const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& border,
+    const QRectF& contentsRect )
+{
+    if ( contentsRect.isEmpty() )
+        return shape.isRectangle() ? ScissorClip : StencilClip;
+
+    if ( !shape.isRectangle() && qskIntersectsCorners( rect, shape, contentsRect ) )
+        return StencilClip;
+
+    const auto innerRect = qskValidOrEmptyInnerRect( rect, border.widths() );
+    return innerRect.contains( contentsRect ) ? NoClip : ScissorClip;
+}
+
+void QskBoxClipNode::setClipMode( ClipMode mode )
+{
+    if ( mode == m_mode )
+        return;
+
+    if ( m_mode == ScissorClip )
+        qskScissorClips.fetchAndSubRelaxed( 1 );
+    else if ( m_mode == StencilClip )
+        qskStencilClips.fetchAndSubRelaxed( 1 );
+
+    if ( mode == ScissorClip )
+        qskScissorClips.fetchAndAddRelaxed( 1 );
+    else if ( mode == StencilClip )
+        qskStencilClips.fetchAndAddRelaxed( 1 );
+
+    m_mode = mode;
+}
+
+QskBoxClipNode::Statistics QskBoxClipNode::statistics()
+{
+    Statistics statistics;
+
+    statistics.scissorClips = qskScissorClips;
+    statistics.stencilClips = qskStencilClips;
+    statistics.avoidedStencilClips = qskAvoidedStencilClips;
+
+    return statistics;
+}
@@ -15,15 +15,66 @@ class QskBoxBorderMetrics;
 class QSK_EXPORT QskBoxClipNode : public QSGClipNode
 {
   public:
+    enum ClipMode : quint8
+    {
+        // the content is inside of the clip region
+        NoClip,
+
+        // rectangular clip, that can be done by a scissor
+        ScissorClip,
+
+        // clip region needs to be rendered into the stencil buffer
+        StencilClip
+    };
+
+    /*
+        Each clip node starts a new clip list for its subtree, what
+        prevents the scene graph renderer from batching its content
+        with anything outside. Stencil clips are more expensive as
+        they need an additional render pass for the clip geometry.
+     */
+    class Statistics
+    {
+      public:
+        // number of existing clip nodes
+        int scissorClips = 0;
+        int stencilClips = 0;
+
+        // rounded clips, that have been done by a scissor
+        quint64 avoidedStencilClips = 0;
+    };
+
     QskBoxClipNode();
     ~QskBoxClipNode() override;
 
     void setBox( const QRectF&,
         const QskBoxShapeMetrics&, const QskBoxBorderMetrics& );
 
+    /*
+        When the clipped content is known to be inside of contentsRect,
+        a rounded box can be clipped by a scissor as long as the content
+        does not reach into the corners.
+     */
+    void setBox( const QRectF&, const QskBoxShapeMetrics&,
+        const QskBoxBorderMetrics&, const QRectF& contentsRect );
+
+    // a rectangular clip, also for empty rectangles
+    void setRect( const QRectF& );
+
+    ClipMode clipMode() const;
+
+    // an empty contentsRect means, that the content is unknown
+    static ClipMode clipMode( const QRectF&, const QskBoxShapeMetrics&,
+        const QskBoxBorderMetrics&, const QRectF& contentsRect );
+
+    static Statistics statistics();
+
   private:
+    void setClipMode( ClipMode );
+
     QskHashValue m_hash;
     QRectF m_rect;
+    ClipMode m_mode;
 
     QSGGeometry m_geometry;
 };
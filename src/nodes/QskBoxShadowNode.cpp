@@ -0,0 +1,552 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskBoxShadowNode.h"
+#include "QskBoxShapeMetrics.h"
+#include "QskShadowMetrics.h"
+#include "QskWindowResourceMap.h"
+
+#include <qcolor.h>
+#include <qglobalstatic.h>
+#include <qhash.h>
+#include <qimage.h>
+#include <qmargins.h>
+#include <qpainter.h>
+#include <qpainterpath.h>
+#include <qquickwindow.h>
+#include <qsgimagenode.h>
+#include <qsgtexture.h>
+
+#include <cstring>
+#include <vector>
+
+// unused textures, that are kept for being reused later
+static const int qskMaxUnusedTextures = 32;
+
+/*
+    The costs of the box blur do not depend on the radius, but the
+    texture grows with it. Beyond this limit - in device pixels - we
+    accept a shadow, that is too sharp.
+ */
+static const int qskMaxBlurRadius = 128;
+
+namespace
+{
+    class Key
+    {
+      public:
+        inline bool operator==( const Key& other ) const
+        {
+            return ( blurRadius == other.blurRadius ) && ( rgba == other.rgba )
+                && ( std::memcmp( radii, other.radii, sizeof( radii ) ) == 0 );
+        }
+
+        inline bool operator!=( const Key& other ) const
+        {
+            return !( *this == other );
+        }
+
+        inline QSize radius( Qt::Corner corner ) const
+        {
+            return QSize( radii[ 2 * corner ], radii[ 2 * corner + 1 ] );
+        }
+
+        // in device pixels, x/y for each corner in the order of Qt::Corner
+        int radii[ 8 ] = {};
+        int blurRadius = 0;
+
+        QRgb rgba = 0;
+    };
+
+    class Entry
+    {
+      public:
+        QSGTexture* texture = nullptr;
+
+        // size of the corners in texture pixels
+        QMargins margins;
+
+        qint64 bytes = 0;
+        int refCount = 0;
+
+        quint64 lastUsed = 0;
+    };
+}
+
+static inline QskHashValue qHash( const Key& key, QskHashValue seed = 0 )
+{
+    auto hash = qHashBits( key.radii, sizeof( key.radii ), seed );
+    hash = qHash( key.blurRadius, hash );
+
+    return qHash( key.rgba, hash );
+}
+
+static QPainterPath qskBoxPath( const QRectF& rect, const Key& key )
+{
+    const QSizeF tl = key.radius( Qt::TopLeftCorner );
+    const QSizeF tr = key.radius( Qt::TopRightCorner );
+    const QSizeF bl = key.radius( Qt::BottomLeftCorner );
+    const QSizeF br = key.radius( Qt::BottomRightCorner );
+
+    QPainterPath path;
+
+    path.moveTo( rect.left(), rect.top() + tl.height() );
+    path.arcTo( QRectF( rect.topLeft(), 2 * tl ), 180.0, -90.0 );
+
+    path.lineTo( rect.right() - tr.width(), rect.top() );
+    path.arcTo( QRectF( rect.right() - 2 * tr.width(), rect.top(),
+        2 * tr.width(), 2 * tr.height() ), 90.0, -90.0 );
+
+    path.lineTo( rect.right(), rect.bottom() - br.height() );
+    path.arcTo( QRectF( rect.right() - 2 * br.width(), rect.bottom() - 2 * br.height(),
+        2 * br.width(), 2 * br.height() ), 0.0, -90.0 );
+
+    path.lineTo( rect.left() + bl.width(), rect.bottom() );
+    path.arcTo( QRectF( rect.left(), rect.bottom() - 2 * bl.height(),
+        2 * bl.width(), 2 * bl.height() ), 270.0, -90.0 );
+
+    path.closeSubpath();
+
+    return path;
+}
+
+static inline int qskBlurFactor( int radius )
+{
+    // fixed point reciprocal of the kernel size
+    const int size = 2 * radius + 1;
+    return ( ( 1 << 16 ) + size / 2 ) / size;
+}
+
+static void qskBlurHorizontal( QImage& mask, int radius )
+{
+    const int w = mask.width();
+    const int factor = qskBlurFactor( radius );
+
+    std::vector< uchar > line( w );
+
+    for ( int y = 0; y < mask.height(); y++ )
+    {
+        auto row = mask.scanLine( y );
+        std::memcpy( line.data(), row, w );
+
+        int sum = 0;
+        for ( int x = 0; x < qMin( radius, w ); x++ )
+            sum += line[ x ];
+
+        for ( int x = 0; x < w; x++ )
+        {
+            if ( x + radius < w )
+                sum += line[ x + radius ];
+
+            row[ x ] = static_cast< uchar >( ( sum * factor ) >> 16 );
+
+            if ( x - radius >= 0 )
+                sum -= line[ x - radius ];
+        }
+    }
+}
+
+static void qskBlurVertical( QImage& mask, int radius )
+{
+    /*
+        Instead of walking along the columns we accumulate complete rows.
+        The inner loops are independent for each pixel, so that the
+        compiler is able to vectorize them.
+     */
+    const int w = mask.width();
+    const int h = mask.height();
+    const int factor = qskBlurFactor( radius );
+
+    const QImage source = mask.copy();
+    std::vector< int > sums( w, 0 );
+
+    for ( int y = 0; y < qMin( radius, h ); y++ )
+    {
+        const auto in = source.constScanLine( y );
+        for ( int x = 0; x < w; x++ )
+            sums[ x ] += in[ x ];
+    }
+
+    for ( int y = 0; y < h; y++ )
+    {
+        if ( y + radius < h )
+        {
+            const auto in = source.constScanLine( y + radius );
+            for ( int x = 0; x < w; x++ )
+                sums[ x ] += in[ x ];
+        }
+
+        auto out = mask.scanLine( y );
+        for ( int x = 0; x < w; x++ )
+            out[ x ] = static_cast< uchar >( ( sums[ x ] * factor ) >> 16 );
+
+        if ( y - radius >= 0 )
+        {
+            const auto in = source.constScanLine( y - radius );
+            for ( int x = 0; x < w; x++ )
+                sums[ x ] -= in[ x ];
+        }
+    }
+}
+
+static void qskBlur( QImage& mask, int radius )
+{
+    // 3 passes of a box blur are a good approximation of a gaussian blur
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        const int r = radius / 3 + ( ( i < radius % 3 ) ? 1 : 0 );
+        if ( r > 0 )
+        {
+            qskBlurHorizontal( mask, r );
+            qskBlurVertical( mask, r );
+        }
+    }
+}
+
+static QImage qskShadowImage( const Key& key, QMargins& margins )
+{
+    const int b = key.blurRadius;
+
+    const int left = qMax( key.radii[ 2 * Qt::TopLeftCorner ],
+        key.radii[ 2 * Qt::BottomLeftCorner ] );
+
+    const int right = qMax( key.radii[ 2 * Qt::TopRightCorner ],
+        key.radii[ 2 * Qt::BottomRightCorner ] );
+
+    const int top = qMax( key.radii[ 2 * Qt::TopLeftCorner + 1 ],
+        key.radii[ 2 * Qt::TopRightCorner + 1 ] );
+
+    const int bottom = qMax( key.radii[ 2 * Qt::BottomLeftCorner + 1 ],
+        key.radii[ 2 * Qt::BottomRightCorner + 1 ] );
+
+    /*
+        The box has a stretchable center of 3 pixels, that is not affected
+        by the blurring of the corners. The middle pixel is the one, that
+        gets stretched, its neighbours avoid artifacts from linear filtering.
+     */
+    const int w = left + right + 2 * b + 3;
+    const int h = top + bottom + 2 * b + 3;
+
+    QImage mask( w + 2 * b, h + 2 * b, QImage::Format_Alpha8 );
+    mask.fill( 0 );
+
+    {
+        QPainter painter( &mask );
+        painter.setRenderHint( QPainter::Antialiasing, true );
+        painter.setPen( Qt::NoPen );
+        painter.setBrush( Qt::black );
+        painter.drawPath( qskBoxPath( QRectF( b, b, w, h ), key ) );
+    }
+
+    qskBlur( mask, b );
+
+    const auto color = QColor::fromRgba( key.rgba );
+
+    QRgb table[ 256 ];
+    for ( int i = 0; i < 256; i++ )
+    {
+        const int alpha = ( color.alpha() * i + 127 ) / 255;
+        table[ i ] = qPremultiply( qRgba( color.red(), color.green(), color.blue(), alpha ) );
+    }
+
+    QImage image( mask.size(), QImage::Format_ARGB32_Premultiplied );
+
+    for ( int y = 0; y < mask.height(); y++ )
+    {
+        const auto in = mask.constScanLine( y );
+        auto out = reinterpret_cast< QRgb* >( image.scanLine( y ) );
+
+        for ( int x = 0; x < mask.width(); x++ )
+            out[ x ] = table[ in[ x ] ];
+    }
+
+    margins = QMargins( left + 2 * b + 1, top + 2 * b + 1,
+        right + 2 * b + 1, bottom + 2 * b + 1 );
+
+    return image;
+}
+
+namespace
+{
+    class ShadowCache
+    {
+      public:
+        ~ShadowCache()
+        {
+            for ( const auto& entry : qAsConst( entries ) )
+                delete entry.texture;
+        }
+
+        Entry acquire( QQuickWindow* window, const Key& key )
+        {
+            auto it = entries.find( key );
+            if ( it != entries.end() )
+            {
+                hits++;
+
+                it->refCount++;
+                it->lastUsed = ++usageCounter;
+
+                return *it;
+            }
+
+            misses++;
+
+            Entry entry;
+
+            const auto image = qskShadowImage( key, entry.margins );
+
+            entry.texture = window->createTextureFromImage(
+                image, QQuickWindow::TextureHasAlphaChannel );
+            entry.texture->setFiltering( QSGTexture::Linear );
+
+            entry.bytes = 4 * qint64( image.width() ) * image.height();
+            entry.refCount = 1;
+            entry.lastUsed = ++usageCounter;
+
+            entries.insert( key, entry );
+
+            return entry;
+        }
+
+        void release( const Key& key )
+        {
+            auto it = entries.find( key );
+            if ( it != entries.end() && --it->refCount <= 0 )
+            {
+                it->refCount = 0;
+                trim();
+            }
+        }
+
+        QHash< Key, Entry > entries;
+
+        quint64 usageCounter = 0;
+        quint64 hits = 0;
+        quint64 misses = 0;
+
+      private:
+        void trim()
+        {
+            int unusedCount = 0;
+            for ( const auto& entry : qAsConst( entries ) )
+            {
+                if ( entry.refCount == 0 )
+                    unusedCount++;
+            }
+
+            while ( unusedCount > qskMaxUnusedTextures )
+            {
+                auto lru = entries.end();
+
+                for ( auto it = entries.begin(); it != entries.end(); ++it )
+                {
+                    if ( it->refCount == 0 )
+                    {
+                        if ( lru == entries.end() || it->lastUsed < lru->lastUsed )
+                            lru = it;
+                    }
+                }
+
+                delete lru->texture;
+                entries.erase( lru );
+
+                unusedCount--;
+            }
+        }
+    };
+}
+
+using CacheMap = QskWindowResourceMap< ShadowCache >;
+Q_GLOBAL_STATIC( CacheMap, qskCacheMap )
+
+class QskBoxShadowNode::PrivateData
+{
+  public:
+    ~PrivateData()
+    {
+        releaseTexture();
+    }
+
+    void releaseTexture()
+    {
+        if ( cache )
+        {
+            QMutexLocker locker( qskCacheMap->mutex() );
+
+            if ( qskCacheMap->contains( cache ) )
+                cache->release( key );
+        }
+
+        cache = nullptr;
+        texture = nullptr;
+    }
+
+    ShadowCache* cache = nullptr;
+    Key key;
+
+    QSGTexture* texture = nullptr;
+    QMargins margins;
+
+    QSGImageNode* patches[ 9 ] = {};
+};
+
+QskBoxShadowNode::QskBoxShadowNode()
+    : m_data( new PrivateData() )
+{
+}
+
+QskBoxShadowNode::~QskBoxShadowNode()
+{
+}
+
+void QskBoxShadowNode::setShadowData( QQuickWindow* window, const QRectF& rect,
+    const QskBoxShapeMetrics& shape, const QskShadowMetrics& shadowMetrics,
+    const QColor& color )
+{
+    if ( window == nullptr )
+        return;
+
+    const auto dpr = window->effectiveDevicePixelRatio();
+
+    const auto metrics = shadowMetrics.toAbsolute( rect.size() );
+    const auto absoluteShape = shape.toAbsolute( rect.size() );
+
+    /*
+        The spread radius grows the box and - like box-shadow in CSS -
+        its rounded corners, so that the shadow keeps the shape of the box.
+        Corners without radius remain sharp.
+     */
+    const auto spread = metrics.spreadRadius();
+
+    Key key;
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        const auto radius = absoluteShape.radius( static_cast< Qt::Corner >( i ) );
+
+        const auto rx = ( radius.width() > 0.0 ) ? radius.width() + spread : 0.0;
+        const auto ry = ( radius.height() > 0.0 ) ? radius.height() + spread : 0.0;
+
+        key.radii[ 2 * i ] = qMax( qRound( rx * dpr ), 0 );
+        key.radii[ 2 * i + 1 ] = qMax( qRound( ry * dpr ), 0 );
+    }
+
+    key.blurRadius = qBound( 0, qRound( metrics.blurRadius() * dpr ), qskMaxBlurRadius );
+    key.rgba = color.rgba();
+
+    auto& d = *m_data;
+
+    if ( d.cache == nullptr || key != d.key )
+    {
+        auto cache = qskCacheMap->resource( window );
+
+        Entry entry;
+        {
+            QMutexLocker locker( qskCacheMap->mutex() );
+            entry = cache->acquire( window, key );
+        }
+
+        d.releaseTexture();
+
+        d.cache = cache;
+        d.key = key;
+        d.texture = entry.texture;
+        d.margins = entry.margins;
+
+        for ( int i = 0; i < 9; i++ )
+        {
+            auto& patch = d.patches[ i ];
+            if ( patch == nullptr )
+            {
+                patch = window->createImageNode();
+                patch->setFiltering( QSGTexture::Linear );
+
+                appendChildNode( patch );
+            }
+
+            patch->setTexture( d.texture );
+        }
+    }
+
+    /*
+        The spread radius grows the box, while the blurred border is
+        around it. Only the stretched parts of the nine-patch depend on
+        the size of the box.
+     */
+    const auto blur = key.blurRadius / dpr;
+    const auto extent = spread + blur;
+
+    const auto outerRect = rect.translated( metrics.offset() ).adjusted(
+        -extent, -extent, extent, extent );
+
+    qreal left = d.margins.left() / dpr;
+    qreal right = d.margins.right() / dpr;
+    qreal top = d.margins.top() / dpr;
+    qreal bottom = d.margins.bottom() / dpr;
+
+    if ( left + right > outerRect.width() )
+    {
+        const auto f = outerRect.width() / ( left + right );
+        left *= f;
+        right *= f;
+    }
+
+    if ( top + bottom > outerRect.height() )
+    {
+        const auto f = outerRect.height() / ( top + bottom );
+        top *= f;
+        bottom *= f;
+    }
+
+    const auto textureSize = d.texture->textureSize();
+
+    const qreal xs[] = { 0.0, qreal( d.margins.left() ),
+        qreal( textureSize.width() - d.margins.right() ), qreal( textureSize.width() ) };
+
+    const qreal ys[] = { 0.0, qreal( d.margins.top() ),
+        qreal( textureSize.height() - d.margins.bottom() ), qreal( textureSize.height() ) };
+
+    const qreal xt[] = { outerRect.left(), outerRect.left() + left,
+        outerRect.right() - right, outerRect.right() };
+
+    const qreal yt[] = { outerRect.top(), outerRect.top() + top,
+        outerRect.bottom() - bottom, outerRect.bottom() };
+
+    for ( int row = 0; row < 3; row++ )
+    {
+        for ( int col = 0; col < 3; col++ )
+        {
+            auto patch = d.patches[ 3 * row + col ];
+
+            patch->setRect( QRectF( QPointF( xt[ col ], yt[ row ] ),
+                QPointF( xt[ col + 1 ], yt[ row + 1 ] ) ) );
+
+            patch->setSourceRect( QRectF( QPointF( xs[ col ], ys[ row ] ),
+                QPointF( xs[ col + 1 ], ys[ row + 1 ] ) ) );
+        }
+    }
+}
+
+QskBoxShadowNode::Statistics QskBoxShadowNode::statistics()
+{
+    Statistics statistics;
+
+    QMutexLocker locker( qskCacheMap->mutex() );
+
+    const auto caches = qskCacheMap->resources();
+    for ( const auto cache : caches )
+    {
+        statistics.textureCount += cache->entries.count();
+        statistics.hits += cache->hits;
+        statistics.misses += cache->misses;
+
+        for ( const auto& entry : qAsConst( cache->entries ) )
+            statistics.memoryUsage += entry.bytes;
+    }
+
+    return statistics;
+}
@@ -0,0 +1,57 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_BOX_SHADOW_NODE_H
+#define QSK_BOX_SHADOW_NODE_H
+
+#include "QskGlobal.h"
+
+#include <qsgnode.h>
+#include <memory>
+
+class QskBoxShapeMetrics;
+class QskShadowMetrics;
+class QColor;
+class QQuickWindow;
+
+/*
+    A blurred shadow of a box, that is displayed as nine-patch of a texture.
+
+    The texture only depends on the corner radii, the blur radius and
+    the color. It is shared between all shadows of the same window with
+    the same parameters, so that resizing a box only changes the geometry.
+    As the texture is blurred on the CPU and displayed by image nodes
+    it is available for all scene graph backends - including the software
+    renderer.
+ */
+class QSK_EXPORT QskBoxShadowNode : public QSGNode
+{
+  public:
+    class Statistics
+    {
+      public:
+        int textureCount = 0;
+        qint64 memoryUsage = 0; // bytes
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+    };
+
+    QskBoxShadowNode();
+    ~QskBoxShadowNode() override;
+
+    // rect is the geometry of the box, that is casting the shadow
+    void setShadowData( QQuickWindow*, const QRectF& rect,
+        const QskBoxShapeMetrics&, const QskShadowMetrics&, const QColor& );
+
+    // accumulated over all windows
+    static Statistics statistics();
+
+  private:
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
@@ -7,10 +7,18 @@
 #include "QskGraphic.h"
 #include "QskColorFilter.h"
 #include "QskPainterCommand.h"
+#include "QskTextureCache.h"
 
-static inline QskHashValue qskHash(
-    const QskGraphic& graphic, const QskColorFilter& colorFilter,
-    QskTextureRenderer::RenderMode renderMode )
+#include <qcoreapplication.h>
+#include <qimage.h>
+#include <qmutex.h>
+#include <qpainter.h>
+#include <qpointer.h>
+#include <qquickwindow.h>
+#include <qrunnable.h>
+#include <qthreadpool.h>
+
+static inline QskHashValue qskColorFilterHash( const QskColorFilter& colorFilter )
 {
     QskHashValue hash = 12000;
 
@@ -21,19 +29,220 @@ static inline QskHashValue qskHash(
             substitutions.size() * sizeof( substitutions[ 0 ] ), hash );
     }
 
+    return hash;
+}
+
+static inline QskHashValue qskHash(
+    const QskGraphic& graphic, const QskColorFilter& colorFilter,
+    QskTextureRenderer::RenderMode renderMode, qreal devicePixelRatio )
+{
+    auto hash = qskColorFilterHash( colorFilter );
+
     hash = graphic.hash( hash );
     hash = qHash( renderMode, hash );
+    hash = qHash( devicePixelRatio, hash );
 
     return hash;
 }
 
+namespace
+{
+    class RasterResult
+    {
+      public:
+        QMutex mutex;
+        QImage image;
+        bool isReady = false;
+
+        // only accessed from the GUI thread, or while it is blocked
+        QPointer< QQuickWindow > window;
+    };
+
+    class RasterNotifier final : public QObject
+    {
+      public:
+        RasterNotifier()
+        {
+            if ( auto app = QCoreApplication::instance() )
+                moveToThread( app->thread() );
+        }
+    };
+
+    QObject* rasterNotifier()
+    {
+        /*
+            Completed tasks are reported through an object living in the
+            GUI thread, so that the workers never touch the window.
+            It is created before the first task is started and therefore
+            destroyed after the global thread pool, that waits for
+            its tasks to finish.
+         */
+        static RasterNotifier notifier;
+        return &notifier;
+    }
+
+    class RasterTask final : public QRunnable
+    {
+      public:
+        RasterTask( const std::shared_ptr< RasterResult >& result,
+                qreal devicePixelRatio, const QskGraphic& graphic,
+                const QskColorFilter& colorFilter, const QSize& size )
+            : m_result( result )
+            , m_graphic( graphic )
+            , m_colorFilter( colorFilter )
+            , m_size( size )
+            , m_ratio( devicePixelRatio )
+        {
+        }
+
+        void run() override
+        {
+            if ( m_result.use_count() == 1 )
+                return; // the node is gone or has lost interest
+
+            QImage image( m_size * m_ratio, QImage::Format_RGBA8888_Premultiplied );
+            image.fill( Qt::transparent );
+
+            {
+                QPainter painter( &image );
+                painter.scale( m_ratio, m_ratio );
+
+                const QRectF rect( 0.0, 0.0, m_size.width(), m_size.height() );
+                m_graphic.render( &painter, rect, m_colorFilter, Qt::IgnoreAspectRatio );
+            }
+
+            {
+                QMutexLocker locker( &m_result->mutex );
+
+                m_result->image = image;
+                m_result->isReady = true;
+            }
+
+            // the upload happens, when the node gets preprocessed
+            const auto result = m_result;
+
+            QMetaObject::invokeMethod( rasterNotifier(),
+                [ result ]()
+                {
+                    if ( result->window )
+                        result->window->update();
+                },
+                Qt::QueuedConnection );
+        }
+
+      private:
+        std::shared_ptr< RasterResult > m_result;
+
+        const QskGraphic m_graphic;
+        const QskColorFilter m_colorFilter;
+        const QSize m_size;
+        const qreal m_ratio;
+    };
+}
+
+static QskTextureCache::Handle qskInsertImage( QskTextureCache* cache,
+    const QskTextureCache::Key& key, QQuickWindow* window, const QImage& image )
+{
+    if ( QskTextureAtlas::isCandidate( image.size() ) )
+    {
+        if ( auto atlas = QskTextureAtlas::atlas( window ) )
+        {
+            const auto entry = atlas->insert( image );
+            if ( entry.isValid() )
+                return cache->insert( key, entry );
+        }
+    }
+
+    const auto textureId = QskTextureRenderer::createTextureFromImage( window, image );
+    return cache->insert( key, textureId, image.size() );
+}
+
+static QskTextureCache::Handle qskCreateCachedTexture(
+    QskTextureCache* cache, const QskTextureCache::Key& key,
+    QQuickWindow* window, QskTextureRenderer::RenderMode renderMode,
+    const QskGraphic& graphic, const QskColorFilter& colorFilter )
+{
+    const auto ratio = key.devicePixelRatio;
+    const auto& size = key.size;
+
+    if ( QskTextureAtlas::isCandidate( size * ratio ) )
+    {
+        /*
+            Small graphics are rasterized into a shared atlas texture, so
+            that the renderer is able to batch them. For those sizes
+            raster painting is usually as fast as using a FBO and offers
+            a better antialiasing.
+         */
+
+        const auto image = QskTextureRenderer::createImageFromGraphic(
+            window, size, graphic, colorFilter, Qt::IgnoreAspectRatio );
+
+        return qskInsertImage( cache, key, window, image );
+    }
+
+    const auto textureId = QskTextureRenderer::createTextureFromGraphic(
+        window, renderMode, size, graphic, colorFilter, Qt::IgnoreAspectRatio );
+
+    return cache->insert( key, textureId, size * ratio );
+}
+
+class QskGraphicNode::PrivateData
+{
+  public:
+    inline void setCacheHandle( const QskTextureCache::Handle& handle )
+    {
+        QskTextureCache::release( cacheHandle );
+        cacheHandle = handle;
+    }
+
+    QskHashValue hash = 0;
+    QskTextureCache::Handle cacheHandle;
+
+    // the window of the most recent update
+    QQuickWindow* window = nullptr;
+
+    QskGraphic placeholder;
+    bool isAsynchronous = false;
+
+    // pending rasterization
+    std::shared_ptr< RasterResult > rasterResult;
+    QskTextureCache::Key rasterKey;
+};
+
 QskGraphicNode::QskGraphicNode()
-    : m_hash( 0 )
+    : m_data( new PrivateData() )
 {
 }
 
 QskGraphicNode::~QskGraphicNode()
 {
+    QskTextureCache::release( m_data->cacheHandle );
+}
+
+void QskGraphicNode::setAsynchronous( bool on )
+{
+    if ( on == m_data->isAsynchronous )
+        return;
+
+    m_data->isAsynchronous = on;
+
+    setFlag( QSGNode::UsePreprocess, on );
+    markDirty( QSGNode::DirtyUsePreprocess );
+}
+
+bool QskGraphicNode::isAsynchronous() const
+{
+    return m_data->isAsynchronous;
+}
+
+void QskGraphicNode::setPlaceholder( const QskGraphic& graphic )
+{
+    m_data->placeholder = graphic;
+}
+
+QskGraphic QskGraphicNode::placeholder() const
+{
+    return m_data->placeholder;
 }
 
 void QskGraphicNode::setGraphic(
@@ -66,20 +275,193 @@ void QskGraphicNode::setGraphic(
         }
     }
 
-    const auto hash = qskHash( graphic, colorFilter, renderMode );
-    if ( hash != m_hash )
+    // f.e. after moving the window to another screen
+    const auto ratio = window ? window->effectiveDevicePixelRatio() : 1.0;
+
+    const auto hash = qskHash( graphic, colorFilter, renderMode, ratio );
+    if ( hash != m_data->hash )
     {
-        m_hash = hash;
+        m_data->hash = hash;
         isTextureDirty = true;
     }
 
-    auto textureId = QskTextureNode::textureId();
+    m_data->window = window;
 
     if ( isTextureDirty )
     {
-        textureId = QskTextureRenderer::createTextureFromGraphic(
-            window, renderMode, textureSize, graphic, colorFilter, Qt::IgnoreAspectRatio );
+        if ( QskTextureCache::cache( window ) == nullptr )
+        {
+            m_data->rasterResult.reset();
+            m_data->setCacheHandle( QskTextureCache::Handle() );
+
+            const auto textureId = QskTextureRenderer::createTextureFromGraphic(
+                window, renderMode, textureSize, graphic, colorFilter, Qt::IgnoreAspectRatio );
+
+            QskTextureNode::setTexture( window, rect, textureId, mirrored );
+            return;
+        }
+
+        updateTexture( window, graphic, colorFilter, renderMode, textureSize );
+    }
+
+    applyTexture( window, rect, mirrored );
+}
+
+void QskGraphicNode::updateTexture( QQuickWindow* window,
+    const QskGraphic& graphic, const QskColorFilter& colorFilter,
+    QskTextureRenderer::RenderMode renderMode, const QSize& textureSize )
+{
+    auto cache = QskTextureCache::cache( window );
+
+    /*
+        QPixmaps can't be used outside of the GUI thread. So graphics
+        with raster data are always rasterized synchronously.
+     */
+    const bool async = m_data->isAsynchronous
+        && !( graphic.commandTypes() & QskGraphic::RasterData );
+
+    if ( async )
+        renderMode = QskTextureRenderer::Raster;
+
+    /*
+        Nodes displaying the same graphic with the same colors
+        and size share their texture.
+     */
+    const auto ratio = window ? window->effectiveDevicePixelRatio() : 1.0;
+
+    const QskTextureCache::Key key( graphic.hash( 0 ),
+        qskColorFilterHash( colorFilter ), textureSize, ratio, renderMode );
+
+    auto handle = cache->acquire( key );
+
+    if ( !handle.isValid() && async )
+    {
+        if ( m_data->rasterResult == nullptr || m_data->rasterKey != key )
+            startRasterTask( window, graphic, colorFilter, key );
+
+        if ( !m_data->cacheHandle.isValid() && !m_data->placeholder.isNull() )
+        {
+            const QskTextureCache::Key placeholderKey( m_data->placeholder.hash( 0 ),
+                qskColorFilterHash( QskColorFilter() ), textureSize, ratio, renderMode );
+
+            handle = cache->acquire( placeholderKey );
+            if ( !handle.isValid() )
+            {
+                handle = qskCreateCachedTexture( cache, placeholderKey,
+                    window, renderMode, m_data->placeholder, QskColorFilter() );
+            }
+
+            m_data->setCacheHandle( handle );
+        }
+
+        return;
+    }
+
+    if ( !handle.isValid() )
+    {
+        handle = qskCreateCachedTexture( cache, key,
+            window, renderMode, graphic, colorFilter );
+    }
+
+    m_data->rasterResult.reset();
+    m_data->setCacheHandle( handle );
+}
+
+void QskGraphicNode::startRasterTask( QQuickWindow* window,
+    const QskGraphic& graphic, const QskColorFilter& colorFilter,
+    const QskTextureCache::Key& key )
+{
+    // a previous task will notice, that nobody is interested anymore
+    m_data->rasterResult = std::make_shared< RasterResult >();
+    m_data->rasterResult->window = window;
+    m_data->rasterKey = key;
+
+    auto task = new RasterTask( m_data->rasterResult,
+        key.devicePixelRatio, graphic, colorFilter, key.size );
+
+    ( void ) rasterNotifier(); // before the thread pool gets created
+    QThreadPool::globalInstance()->start( task );
+}
+
+void QskGraphicNode::preprocess()
+{
+    auto& result = m_data->rasterResult;
+    if ( result == nullptr )
+        return;
+
+    QImage image;
+
+    {
+        QMutexLocker locker( &result->mutex );
+        if ( !result->isReady )
+            return;
+
+        image = result->image;
+    }
+
+    result.reset();
+
+    auto window = m_data->window;
+
+    auto cache = QskTextureCache::cache( window );
+    if ( cache == nullptr )
+    {
+        // without cache the node owns the texture
+        m_data->setCacheHandle( QskTextureCache::Handle() );
+
+        const auto textureId = QskTextureRenderer::createTextureFromImage( window, image );
+        QskTextureNode::setTexture( window, rect(), textureId, mirrored() );
+
+        return;
+    }
+
+    const auto& key = m_data->rasterKey;
+
+    // another node might have been faster
+    auto handle = cache->acquire( key );
+    if ( !handle.isValid() )
+        handle = qskInsertImage( cache, key, window, image );
+
+    m_data->setCacheHandle( handle );
+    applyTexture( window, rect(), mirrored() );
+}
+
+void QskGraphicNode::reset()
+{
+    // a running task will notice, that nobody is interested anymore
+    m_data->rasterResult.reset();
+
+    m_data->placeholder = QskGraphic();
+    setAsynchronous( false );
+
+    if ( m_data->cacheHandle.isValid() )
+    {
+        /*
+            Unreferencing the cache entry, so that it can be evicted.
+            Reusing the node for the same graphic will find it in
+            the cache again - as long as it is not gone.
+         */
+        m_data->setCacheHandle( QskTextureCache::Handle() );
+        m_data->hash = 0;
+
+        QskTextureNode::setTexture( m_data->window, rect(), 0, mirrored() );
     }
+}
 
-    QskTextureNode::setTexture( window, rect, textureId, mirrored );
+void QskGraphicNode::applyTexture(
+    QQuickWindow* window, const QRectF& rect, Qt::Orientations mirrored )
+{
+    const auto& handle = m_data->cacheHandle;
+
+    if ( handle.isValid() )
+    {
+        QskTextureNode::setSharedTexture( window, rect,
+            handle.textureId, handle.textureRect, mirrored );
+    }
+    else
+    {
+        // a shared texture is gone with its handle
+        const auto id = isTextureShared() ? 0 : textureId();
+        QskTextureNode::setTexture( window, rect, id, mirrored );
+    }
 }
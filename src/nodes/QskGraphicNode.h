@@ -6,9 +6,12 @@
 #ifndef QSK_GRAPHIC_NODE_H
 #define QSK_GRAPHIC_NODE_H
 
+#include "QskTextureCache.h"
 #include "QskTextureRenderer.h"
 #include "QskTextureNode.h"
 
+#include <memory>
+
 class QskGraphic;
 class QskColorFilter;
 class QQuickWindow;
@@ -24,11 +27,42 @@ class QSK_EXPORT QskGraphicNode : public QskTextureNode
         QskTextureRenderer::RenderMode, const QRectF&,
         Qt::Orientations mirrored = Qt::Orientations() );
 
+    /*
+        In asynchronous mode graphics are rasterized by a thread pool and
+        uploaded in the next frame. Until then the previous texture - or
+        the placeholder, when there is none - remains visible.
+     */
+    void setAsynchronous( bool );
+    bool isAsynchronous() const;
+
+    void setPlaceholder( const QskGraphic& );
+    QskGraphic placeholder() const;
+
+    void preprocess() override;
+
+    /*
+        Releases the cached texture, the placeholder and a pending
+        rasterization - f.e. before the node is parked in a QskNodePool.
+     */
+    void reset();
+
   private:
     void setTexture( QQuickWindow*,
         const QRectF&, uint id, Qt::Orientations ) = delete;
 
-    QskHashValue m_hash;
+    void setSharedTexture( QQuickWindow*, const QRectF&,
+        uint id, const QRectF&, Qt::Orientations ) = delete;
+
+    void updateTexture( QQuickWindow*, const QskGraphic&,
+        const QskColorFilter&, QskTextureRenderer::RenderMode, const QSize& );
+
+    void startRasterTask( QQuickWindow*, const QskGraphic&,
+        const QskColorFilter&, const QskTextureCache::Key& );
+
+    void applyTexture( QQuickWindow*, const QRectF&, Qt::Orientations );
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
 };
 
 #endif
@@ -0,0 +1,309 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskGraphicTessellator.h"
+#include "QskColorFilter.h"
+#include "QskGraphic.h"
+#include "QskPainterCommand.h"
+#include "QskVertex.h"
+
+#include <qglobalstatic.h>
+#include <qhash.h>
+#include <qmutex.h>
+#include <qpainterpath.h>
+#include <qpen.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qtriangulator_p.h>
+QSK_QT_PRIVATE_END
+
+// number of tessellated graphics, that are kept
+static const int qskMaxCacheEntries = 100;
+
+namespace
+{
+    class CacheKey
+    {
+      public:
+        inline bool operator==( const CacheKey& other ) const
+        {
+            return ( graphicHash == other.graphicHash )
+                && ( colorFilterHash == other.colorFilterHash )
+                && ( scale == other.scale );
+        }
+
+        QskHashValue graphicHash;
+        QskHashValue colorFilterHash;
+        qreal scale;
+    };
+
+    class CacheEntry
+    {
+      public:
+        QskGraphicTessellator::Triangles triangles;
+        quint64 lastUsed = 0;
+    };
+
+    inline QskHashValue qHash( const CacheKey& key, QskHashValue seed = 0 )
+    {
+        auto hash = qHash( key.graphicHash, seed );
+        hash = qHash( key.colorFilterHash, hash );
+
+        return qHash( key.scale, hash );
+    }
+
+    class Cache
+    {
+      public:
+        QMutex mutex;
+        QHash< CacheKey, CacheEntry > entries;
+        quint64 usageCounter = 0;
+    };
+}
+
+Q_GLOBAL_STATIC( Cache, qskCache )
+
+static inline QskHashValue qskColorFilterHash( const QskColorFilter& colorFilter )
+{
+    QskHashValue hash = 12000;
+
+    const auto& substitutions = colorFilter.substitutions();
+    if ( substitutions.size() > 0 )
+    {
+        hash = qHashBits( substitutions.constData(),
+            substitutions.size() * sizeof( substitutions[ 0 ] ), hash );
+    }
+
+    return hash;
+}
+
+static inline bool qskIsSolid( const QBrush& brush )
+{
+    return ( brush.style() == Qt::SolidPattern ) || ( brush.style() == Qt::NoBrush );
+}
+
+static inline QskVertex::Color qskVertexColor( QColor color, qreal opacity )
+{
+    if ( opacity < 1.0 )
+        color.setAlphaF( color.alphaF() * opacity );
+
+    return QskVertex::Color( color ); // premultiplied
+}
+
+template< typename Index >
+static inline void qskAppendTriangles(
+    const QTriangleSet& set, const Index* indices,
+    qreal scale, QskVertex::Color color, QskGraphicTessellator::Triangles& triangles )
+{
+    const auto count = set.indices.size();
+    const auto v = set.vertices.constData();
+
+    auto points = triangles.data() + triangles.size() - count;
+
+    for ( uint i = 0; i < count; i++ )
+    {
+        const auto idx = 2 * indices[ i ];
+
+        points[ i ].set( v[ idx ] / scale, v[ idx + 1 ] / scale,
+            color.r, color.g, color.b, color.a );
+    }
+}
+
+static void qskTessellatePath( const QPainterPath& path,
+    const QTransform& transform, qreal scale,
+    QskVertex::Color color, QskGraphicTessellator::Triangles& triangles )
+{
+    /*
+        Flattening the curves in a coordinate system, that is
+        scaled like the target and mapping the vertices back
+        to the coordinates of the graphic.
+     */
+    const auto matrix = transform * QTransform::fromScale( scale, scale );
+
+    const auto set = qTriangulate( path, matrix );
+
+    const int count = set.indices.size();
+    if ( count == 0 )
+        return;
+
+    triangles.resize( triangles.size() + count );
+
+    if ( set.indices.type() == QVertexIndexVector::UnsignedInt )
+    {
+        const auto indices = static_cast< const quint32* >( set.indices.data() );
+        qskAppendTriangles( set, indices, scale, color, triangles );
+    }
+    else
+    {
+        const auto indices = static_cast< const quint16* >( set.indices.data() );
+        qskAppendTriangles( set, indices, scale, color, triangles );
+    }
+}
+
+bool QskGraphicTessellator::isSupported( const QskGraphic& graphic )
+{
+    if ( graphic.isEmpty() || ( graphic.commandTypes() & QskGraphic::RasterData ) )
+        return false;
+
+    if ( graphic.testRenderHint( QskGraphic::RenderPensUnscaled ) )
+        return false;
+
+    for ( const auto& command : graphic.commands() )
+    {
+        if ( command.type() != QskPainterCommand::State )
+            continue;
+
+        const auto data = command.stateData();
+        const auto flags = data->flags;
+
+        if ( flags & QPaintEngine::DirtyPen )
+        {
+            const auto& pen = data->pen;
+
+            if ( pen.style() != Qt::NoPen )
+            {
+                if ( pen.isCosmetic() || !qskIsSolid( pen.brush() ) )
+                    return false;
+            }
+        }
+
+        if ( flags & QPaintEngine::DirtyBrush )
+        {
+            if ( !qskIsSolid( data->brush ) )
+                return false;
+        }
+
+        if ( flags & QPaintEngine::DirtyTransform )
+        {
+            if ( data->transform.type() == QTransform::TxProject )
+                return false;
+        }
+
+        if ( ( flags & QPaintEngine::DirtyClipEnabled ) && data->isClipEnabled )
+            return false;
+
+        if ( flags & ( QPaintEngine::DirtyClipRegion | QPaintEngine::DirtyClipPath ) )
+        {
+            if ( data->clipOperation != Qt::NoClip )
+                return false;
+        }
+
+        if ( flags & QPaintEngine::DirtyCompositionMode )
+        {
+            if ( data->compositionMode != QPainter::CompositionMode_SourceOver )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+QskGraphicTessellator::Triangles QskGraphicTessellator::triangles(
+    const QskGraphic& graphic, const QskColorFilter& colorFilter, qreal scale )
+{
+    const CacheKey key { graphic.hash( 0 ), qskColorFilterHash( colorFilter ), scale };
+
+    {
+        QMutexLocker locker( &qskCache->mutex );
+
+        auto it = qskCache->entries.find( key );
+        if ( it != qskCache->entries.end() )
+        {
+            it->lastUsed = ++qskCache->usageCounter;
+            return it->triangles;
+        }
+    }
+
+    const auto triangles = tessellate( graphic, colorFilter, scale );
+
+    QMutexLocker locker( &qskCache->mutex );
+
+    auto& entries = qskCache->entries;
+
+    if ( entries.count() >= qskMaxCacheEntries )
+    {
+        auto lru = entries.begin();
+        for ( auto it = entries.begin(); it != entries.end(); ++it )
+        {
+            if ( it->lastUsed < lru->lastUsed )
+                lru = it;
+        }
+
+        entries.erase( lru );
+    }
+
+    CacheEntry entry;
+    entry.triangles = triangles;
+    entry.lastUsed = ++qskCache->usageCounter;
+
+    entries.insert( key, entry );
+
+    return triangles;
+}
+
+QskGraphicTessellator::Triangles QskGraphicTessellator::tessellate(
+    const QskGraphic& graphic, const QskColorFilter& colorFilter, qreal scale )
+{
+    Triangles triangles;
+
+    if ( scale <= 0.0 || !isSupported( graphic ) )
+        return triangles;
+
+    // the initial state of a QPainter
+
+    QPen pen;
+    QBrush brush;
+    QTransform transform;
+    qreal opacity = 1.0;
+
+    for ( const auto& command : graphic.commands() )
+    {
+        switch ( command.type() )
+        {
+            case QskPainterCommand::Path:
+            {
+                const auto& path = *command.path();
+
+                if ( brush.style() != Qt::NoBrush )
+                {
+                    const auto color = qskVertexColor( brush.color(), opacity );
+                    qskTessellatePath( path, transform, scale, color, triangles );
+                }
+
+                if ( pen.style() != Qt::NoPen )
+                {
+                    const auto stroke = QPainterPathStroker( pen ).createStroke( path );
+
+                    const auto color = qskVertexColor( pen.color(), opacity );
+                    qskTessellatePath( stroke, transform, scale, color, triangles );
+                }
+
+                break;
+            }
+            case QskPainterCommand::State:
+            {
+                const auto data = command.stateData();
+
+                if ( data->flags & QPaintEngine::DirtyPen )
+                    pen = colorFilter.substituted( data->pen );
+
+                if ( data->flags & QPaintEngine::DirtyBrush )
+                    brush = colorFilter.substituted( data->brush );
+
+                if ( data->flags & QPaintEngine::DirtyTransform )
+                    transform = data->transform;
+
+                if ( data->flags & QPaintEngine::DirtyOpacity )
+                    opacity = data->opacity;
+
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return triangles;
+}
@@ -0,0 +1,43 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_GRAPHIC_TESSELLATOR_H
+#define QSK_GRAPHIC_TESSELLATOR_H
+
+#include "QskGlobal.h"
+
+#include <qsggeometry.h>
+#include <qvector.h>
+
+class QskGraphic;
+class QskColorFilter;
+
+/*
+    Converting the paths of a graphic into triangles, that can be
+    displayed without rasterizing them into a texture first.
+
+    Only paths with solid brushes and scalable solid pens are supported.
+    For anything else - gradients, images, clipping, composition modes ...
+    the graphic has to be rendered into a texture.
+
+    The triangles are in the coordinate system of the graphic. Curves are
+    flattened according to scale, so that they look smooth when being
+    displayed with a scale factor up to the same value.
+ */
+namespace QskGraphicTessellator
+{
+    using Triangles = QVector< QSGGeometry::ColoredPoint2D >;
+
+    QSK_EXPORT bool isSupported( const QskGraphic& );
+
+    // results are cached
+    QSK_EXPORT Triangles triangles(
+        const QskGraphic&, const QskColorFilter&, qreal scale );
+
+    QSK_EXPORT Triangles tessellate(
+        const QskGraphic&, const QskColorFilter&, qreal scale );
+}
+
+#endif
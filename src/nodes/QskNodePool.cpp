@@ -0,0 +1,339 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskNodePool.h"
+#include "QskBoxNode.h"
+#include "QskGraphicNode.h"
+#include "QskTextNode.h"
+#include "QskWindowResourceMap.h"
+
+#include <qglobalstatic.h>
+#include <qmatrix4x4.h>
+#include <qset.h>
+#include <qvector.h>
+
+#include <typeinfo>
+
+static QAtomicInt qskMaxNodeCount( 256 );
+
+// the pool of the window, whose nodes are updated in the current thread
+static thread_local QskNodePool* qskCurrentPool = nullptr;
+
+using PoolMap = QskWindowResourceMap< QskNodePool >;
+Q_GLOBAL_STATIC( PoolMap, qskPoolMap )
+
+namespace
+{
+    enum NodeType
+    {
+        NoType = -1,
+
+        BoxNode,
+        TextNode,
+        GraphicNode,
+        TransformNode,
+
+        NodeTypeCount
+    };
+}
+
+static inline NodeType qskNodeType( const QSGNode* node )
+{
+    /*
+        Derived classes might have state, that can't be reset.
+        So we only accept nodes of exactly these types.
+     */
+    const auto& type = typeid( *node );
+
+    if ( type == typeid( QskBoxNode ) )
+        return BoxNode;
+
+    if ( type == typeid( QskTextNode ) )
+        return TextNode;
+
+    if ( type == typeid( QskGraphicNode ) )
+        return GraphicNode;
+
+    if ( type == typeid( QSGTransformNode ) )
+        return TransformNode;
+
+    return NoType;
+}
+
+class QskNodePool::PrivateData
+{
+  public:
+    mutable QMutex mutex;
+
+    QVector< QSGNode* > nodes[ NodeTypeCount ];
+
+    quint64 allocations = 0;
+    quint64 reused = 0;
+    quint64 recycled = 0;
+    quint64 discarded = 0;
+};
+
+QskNodePool::Scope::Scope( QQuickWindow* window )
+    : m_previousPool( qskCurrentPool )
+{
+    qskCurrentPool = QskNodePool::pool( window );
+}
+
+QskNodePool::Scope::~Scope()
+{
+    qskCurrentPool = m_previousPool;
+}
+
+QskNodePool::QskNodePool()
+    : m_data( new PrivateData() )
+{
+}
+
+QskNodePool::~QskNodePool()
+{
+    purge();
+}
+
+QskNodePool* QskNodePool::pool( QQuickWindow* window )
+{
+    if ( window == nullptr )
+        return nullptr;
+
+    return qskPoolMap->resource( window );
+}
+
+QskNodePool* QskNodePool::currentPool()
+{
+    return qskCurrentPool;
+}
+
+void QskNodePool::attachWindow( QQuickWindow* window )
+{
+    if ( window == nullptr )
+        return;
+
+    static QSet< const QQuickWindow* > windows;
+
+    if ( windows.contains( window ) )
+        return;
+
+    windows.insert( window );
+
+    /*
+        The scene graph might run on a different thread, so we need
+        direct connections. As QObject::sender() is not valid then,
+        the window is passed by the lambda.
+     */
+
+    QObject::connect( window, &QQuickWindow::beforeSynchronizing,
+        window, [ window ] { qskCurrentPool = pool( window ); },
+        Qt::DirectConnection );
+
+    QObject::connect( window, &QQuickWindow::afterSynchronizing,
+        window, [] { qskCurrentPool = nullptr; },
+        Qt::DirectConnection );
+
+    QObject::connect( window, &QObject::destroyed,
+        [ window ] { windows.remove( window ); } );
+}
+
+QskBoxNode* QskNodePool::createBoxNode()
+{
+    if ( auto pool = currentPool() )
+    {
+        if ( auto node = pool->take( BoxNode ) )
+            return static_cast< QskBoxNode* >( node );
+    }
+
+    return new QskBoxNode();
+}
+
+QskTextNode* QskNodePool::createTextNode()
+{
+    if ( auto pool = currentPool() )
+    {
+        if ( auto node = pool->take( TextNode ) )
+            return static_cast< QskTextNode* >( node );
+    }
+
+    return new QskTextNode();
+}
+
+QskGraphicNode* QskNodePool::createGraphicNode()
+{
+    if ( auto pool = currentPool() )
+    {
+        if ( auto node = pool->take( GraphicNode ) )
+            return static_cast< QskGraphicNode* >( node );
+    }
+
+    return new QskGraphicNode();
+}
+
+QSGTransformNode* QskNodePool::createTransformNode()
+{
+    if ( auto pool = currentPool() )
+    {
+        if ( auto node = pool->take( TransformNode ) )
+            return static_cast< QSGTransformNode* >( node );
+    }
+
+    return new QSGTransformNode();
+}
+
+void QskNodePool::release( QSGNode* node )
+{
+    if ( node == nullptr )
+        return;
+
+    if ( auto parentNode = node->parent() )
+        parentNode->removeChildNode( node );
+
+    if ( auto pool = currentPool() )
+        pool->recycle( node );
+    else
+        delete node;
+}
+
+void QskNodePool::setMaxNodeCount( int count )
+{
+    qskMaxNodeCount = qMax( count, 0 );
+}
+
+int QskNodePool::maxNodeCount()
+{
+    return qskMaxNodeCount;
+}
+
+QskNodePool::Statistics QskNodePool::globalStatistics()
+{
+    Statistics statistics;
+
+    QMutexLocker locker( qskPoolMap->mutex() );
+
+    const auto pools = qskPoolMap->resources();
+    for ( const auto pool : pools )
+    {
+        const auto s = pool->statistics();
+
+        statistics.nodeCount += s.nodeCount;
+        statistics.allocations += s.allocations;
+        statistics.reused += s.reused;
+        statistics.recycled += s.recycled;
+        statistics.discarded += s.discarded;
+    }
+
+    return statistics;
+}
+
+QskNodePool::Statistics QskNodePool::statistics() const
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    Statistics statistics;
+
+    for ( const auto& nodes : m_data->nodes )
+        statistics.nodeCount += nodes.count();
+
+    statistics.allocations = m_data->allocations;
+    statistics.reused = m_data->reused;
+    statistics.recycled = m_data->recycled;
+    statistics.discarded = m_data->discarded;
+
+    return statistics;
+}
+
+void QskNodePool::purge()
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    for ( auto& nodes : m_data->nodes )
+    {
+        qDeleteAll( nodes );
+        nodes.clear();
+    }
+}
+
+QSGNode* QskNodePool::take( int nodeType )
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    auto& nodes = m_data->nodes[ nodeType ];
+
+    if ( nodes.isEmpty() )
+    {
+        m_data->allocations++;
+        return nullptr;
+    }
+
+    m_data->reused++;
+
+    auto node = nodes.last();
+    nodes.removeLast();
+
+    return node;
+}
+
+void QskNodePool::recycle( QSGNode* node )
+{
+    const auto nodeType = qskNodeType( node );
+
+    if ( nodeType == NoType )
+    {
+        delete node;
+        return;
+    }
+
+    {
+        QMutexLocker locker( &m_data->mutex );
+
+        if ( m_data->nodes[ nodeType ].count() >= maxNodeCount() )
+        {
+            m_data->discarded++;
+            locker.unlock();
+
+            delete node;
+            return;
+        }
+    }
+
+    // clearing the node role, see QskSGNode
+    node->setFlags( static_cast< QSGNode::Flags >( 0xff00 ), false );
+
+    if ( nodeType == TransformNode )
+    {
+        auto transformNode = static_cast< QSGTransformNode* >( node );
+        transformNode->setMatrix( QMatrix4x4() );
+
+        // the children of a transform node are unrelated to it
+        while ( auto childNode = node->firstChild() )
+        {
+            node->removeChildNode( childNode );
+
+            if ( childNode->flags() & QSGNode::OwnedByParent )
+                recycle( childNode );
+        }
+    }
+
+    if ( nodeType == GraphicNode )
+    {
+        /*
+            Parked nodes must not keep references on the texture cache,
+            as those entries could never be evicted.
+         */
+        static_cast< QskGraphicNode* >( node )->reset();
+    }
+
+    /*
+        Other nodes keep their children, geometry and material. Those are
+        updated, when the node is reused - in case of the same content
+        the update is a noop.
+     */
+
+    QMutexLocker locker( &m_data->mutex );
+
+    m_data->nodes[ nodeType ] += node;
+    m_data->recycled++;
+}
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_NODE_POOL_H
+#define QSK_NODE_POOL_H
+
+#include "QskGlobal.h"
+#include <memory>
+
+class QskBoxNode;
+class QskTextNode;
+class QskGraphicNode;
+
+class QSGNode;
+class QSGTransformNode;
+class QQuickWindow;
+
+/*
+    A per window pool of scene graph nodes, that are frequently created
+    and removed by the skinlets - f.e when scrolling through a list view
+    or when the number of samples changes.
+
+    Instead of being deleted, nodes are kept in the pool and recycled
+    with their geometry buffers and texts. As nodes of the pool have been
+    used for the same window, they might even have the same content,
+    so that updating them is for free.
+
+    The pool of an attached window is current in the render thread, while
+    its scene graph is synchronized. So the pool is looked up once per
+    frame - not for each item. Without current pool nodes are simply
+    created and deleted.
+ */
+class QSK_EXPORT QskNodePool
+{
+  public:
+    class Statistics
+    {
+      public:
+        // nodes waiting for being reused
+        int nodeCount = 0;
+
+        quint64 allocations = 0;
+        quint64 reused = 0;
+
+        quint64 recycled = 0;
+        quint64 discarded = 0; // the pool was full
+    };
+
+    class Scope
+    {
+      public:
+        Scope( QQuickWindow* );
+        ~Scope();
+
+      private:
+        Q_DISABLE_COPY( Scope )
+        QskNodePool* m_previousPool;
+    };
+
+    QskNodePool();
+    ~QskNodePool();
+
+    static QskNodePool* pool( QQuickWindow* );
+    static QskNodePool* currentPool();
+
+    // the pool is current while synchronizing, has to be called from the GUI thread
+    static void attachWindow( QQuickWindow* );
+
+    static QskBoxNode* createBoxNode();
+    static QskTextNode* createTextNode();
+    static QskGraphicNode* createGraphicNode();
+    static QSGTransformNode* createTransformNode();
+
+    /*
+        Removes the node from its parent and puts it into the current pool.
+        Nodes of other types, or when the pool is full, are deleted.
+     */
+    static void release( QSGNode* );
+
+    // per node type, 0 disables recycling
+    static void setMaxNodeCount( int );
+    static int maxNodeCount();
+
+    // accumulated over the pools of all windows
+    static Statistics globalStatistics();
+
+    Statistics statistics() const;
+    void purge();
+
+  private:
+    Q_DISABLE_COPY( QskNodePool )
+
+    QSGNode* take( int nodeType );
+    void recycle( QSGNode* );
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
@@ -6,6 +6,10 @@
 #include "QskPaintedNode.h"
 #include "QskTextureRenderer.h"
 
+#include <qpainter.h>
+#include <qquickwindow.h>
+#include <qregion.h>
+
 class QskPaintedNode::PaintHelper : public QskTextureRenderer::PaintHelper
 {
   public:
@@ -19,6 +23,11 @@ class QskPaintedNode::PaintHelper : public QskTextureRenderer::PaintHelper
         m_node->paint( painter, size );
     }
 
+    bool isThreadSafe() const override
+    {
+        return m_node->isPaintThreadSafe();
+    }
+
   private:
     QskPaintedNode* m_node;
 };
@@ -31,6 +40,19 @@ QskPaintedNode::~QskPaintedNode()
 {
 }
 
+void QskPaintedNode::setIncremental( bool on )
+{
+    m_incremental = on;
+
+    if ( !on )
+        m_image = QImage();
+}
+
+bool QskPaintedNode::isIncremental() const
+{
+    return m_incremental;
+}
+
 void QskPaintedNode::update( QQuickWindow* window,
     QskTextureRenderer::RenderMode renderMode, const QRect& rect )
 {
@@ -43,21 +65,109 @@ void QskPaintedNode::update( QQuickWindow* window,
             ( rect.height() != static_cast< int >( oldRect.height() ) );
     }
 
+    const auto ratio = window ? window->effectiveDevicePixelRatio() : 1.0;
+    if ( ratio != m_devicePixelRatio )
+    {
+        // the retained image has the resolution of the previous ratio
+        m_devicePixelRatio = ratio;
+        isTextureDirty = true;
+    }
+
+    bool isContentDirty = false;
+
     const auto newHash = hash();
     if ( ( newHash == 0 ) || ( newHash != m_hash ) )
     {
         m_hash = newHash;
-        isTextureDirty = true;
+        isContentDirty = true;
     }
 
     auto textureId = QskTextureNode::textureId();
 
-    if ( isTextureDirty )
+    if ( isContentDirty && !isTextureDirty && m_incremental )
+    {
+        /*
+            When only a small part has changed - f.e a needle of a dial -
+            we can avoid repainting and uploading everything
+         */
+        if ( updateDirtyRegion( window, dirtyRegion() ) )
+        {
+            QskTextureNode::setTexture( window, rect, textureId );
+            return;
+        }
+    }
+
+    if ( isTextureDirty || isContentDirty )
     {
         PaintHelper helper( this );
-        textureId = QskTextureRenderer::createTexture(
-            window, renderMode, rect.size(), &helper );
+
+        renderMode = QskTextureRenderer::effectiveRenderMode( window, renderMode );
+
+        if ( renderMode == QskTextureRenderer::Raster )
+        {
+            const auto image = QskTextureRenderer::createImage( window, rect.size(), &helper );
+            textureId = QskTextureRenderer::createTextureFromImage( window, image );
+
+            m_image = m_incremental ? image : QImage();
+        }
+        else
+        {
+            m_image = QImage();
+            textureId = QskTextureRenderer::createTexture(
+                window, renderMode, rect.size(), &helper );
+        }
     }
 
     QskTextureNode::setTexture( window, rect, textureId );
 }
+
+bool QskPaintedNode::updateDirtyRegion( QQuickWindow* window, const QRegion& region )
+{
+    if ( region.isEmpty() || m_image.isNull() || isNull() )
+        return false;
+
+    const auto ratio = window ? window->effectiveDevicePixelRatio() : 1.0;
+
+    // aligning the dirty rectangles to device pixels
+
+    QRegion deviceRegion;
+
+    for ( const auto& r : region )
+    {
+        const QRectF rect( r.x() * ratio, r.y() * ratio,
+            r.width() * ratio, r.height() * ratio );
+
+        deviceRegion += rect.toAlignedRect() & m_image.rect();
+    }
+
+    if ( deviceRegion.isEmpty() )
+        return true; // nothing visible has changed
+
+    {
+        QPainter painter( &m_image );
+        painter.setClipRegion( deviceRegion );
+
+        painter.setCompositionMode( QPainter::CompositionMode_Source );
+        painter.fillRect( m_image.rect(), Qt::transparent );
+        painter.setCompositionMode( QPainter::CompositionMode_SourceOver );
+
+        painter.scale( ratio, ratio );
+
+        paint( &painter, QskTextureNode::rect().size() );
+    }
+
+    for ( const auto& r : deviceRegion )
+        QskTextureRenderer::updateTextureFromImage( textureId(), m_image, r );
+
+    return true;
+}
+
+QRegion QskPaintedNode::dirtyRegion() const
+{
+    return QRegion();
+}
+
+bool QskPaintedNode::isPaintThreadSafe() const
+{
+    return false;
+}
@@ -9,6 +9,10 @@
 #include "QskTextureNode.h"
 #include "QskTextureRenderer.h"
 
+#include <qimage.h>
+
+class QRegion;
+
 class QSK_EXPORT QskPaintedNode : public QskTextureNode
 {
   public:
@@ -18,19 +22,53 @@ class QSK_EXPORT QskPaintedNode : public QskTextureNode
     void update( QQuickWindow*,
         QskTextureRenderer::RenderMode, const QRect& );
 
+    /*
+        An incremental node retains its content in an image, when being
+        painted by the raster paint engine. Then only the dirtyRegion()
+        is repainted and uploaded. As the image costs 4 bytes per pixel
+        it is disabled by default.
+     */
+    void setIncremental( bool );
+    bool isIncremental() const;
+
   protected:
     virtual void paint( QPainter*, const QSizeF& ) = 0;
 
     // a hash value of '0' always results in repainting
     virtual QskHashValue hash() const = 0;
 
+    /*
+        The parts of the node, that have been changed since the last paint,
+        in the coordinates of paint(). For incremental nodes, that have been
+        painted by the raster paint engine, only these parts are repainted
+        and uploaded.
+
+        The default implementation returns an empty region,
+        what results in repainting everything.
+     */
+    virtual QRegion dirtyRegion() const;
+
+    /*
+        Large textures are painted in parallel, when paint() can be
+        called from different threads at the same time. The default
+        implementation returns false.
+     */
+    virtual bool isPaintThreadSafe() const;
+
   private:
     class PaintHelper;
 
+    bool updateDirtyRegion( QQuickWindow*, const QRegion& );
+
     void setTexture( QQuickWindow*,
         const QRectF&, uint id, Qt::Orientations ) = delete;
 
     QskHashValue m_hash;
+    qreal m_devicePixelRatio = 0.0;
+    bool m_incremental = false;
+
+    // the retained content of incremental nodes, when painting with Raster
+    QImage m_image;
 };
 
 #endif
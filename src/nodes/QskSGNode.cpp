@@ -4,14 +4,14 @@
  *****************************************************************************/
 
 #include "QskSGNode.h"
+#include "QskNodePool.h"
 
 static inline void qskRemoveChildNode( QSGNode* parent, QSGNode* child )
 {
     parent->removeChildNode( child );
 
     if ( child->flags() & QSGNode::OwnedByParent )
-        delete child;
-
+        QskNodePool::release( child );
 }
 
 static inline void qskRemoveAllChildNodesAfter( QSGNode* parent, QSGNode* child )
@@ -149,9 +149,5 @@ void QskSGNode::replaceChildNode(
     }
 
     if ( oldNode && oldNode != newNode )
-    {
-        parentNode->removeChildNode( oldNode );
-        if ( oldNode->flags() & QSGNode::OwnedByParent )
-            delete oldNode;
-    }
+        qskRemoveChildNode( parentNode, oldNode );
 }
@@ -9,22 +9,69 @@
 #include "QskSGNode.h"
 #include "QskTickmarksNode.h"
 #include "QskTextNode.h"
-#include "QskGraphicNode.h"
 #include "QskTextOptions.h"
 #include "QskTextColors.h"
 #include "QskGraphic.h"
 #include "QskColorFilter.h"
 #include "QskControl.h"
 #include "QskIntervalF.h"
+#include "QskNodePool.h"
 #include "QskFunctions.h"
 
-#include <qstring.h>
 #include <qfontmetrics.h>
+#include <qmap.h>
+#include <qstring.h>
+#include <qvector.h>
 
-static QSGNode* qskRemoveTraillingNodes( QSGNode* node, QSGNode* childNode )
+namespace
 {
-    QskSGNode::removeAllChildNodesFrom( node, childNode );
-    return nullptr;
+    enum LabelNodeRole
+    {
+        TextNode = 1,
+        GraphicNode = 2
+    };
+
+    class Label
+    {
+      public:
+        qreal tick = 0.0;
+
+        QString text;
+        QskGraphic graphic;
+
+        QRectF rect;
+        Qt::Alignment alignment;
+    };
+
+    class LabelsNode final : public QSGNode
+    {
+      public:
+        // the nodes of the displayed labels by their tick value
+        QMap< qreal, QSGNode* > labelNodes;
+    };
+}
+
+static QSGNode* qskTakeLabelNode(
+    QMap< qreal, QSGNode* >& nodes, qreal tick, qreal epsilon )
+{
+    // tick values might differ slightly, when being calculated for other boundaries
+
+    auto it = nodes.lowerBound( tick - epsilon );
+    if ( it == nodes.end() || it.key() > tick + epsilon )
+        return nullptr;
+
+    auto node = it.value();
+    nodes.erase( it );
+
+    return node;
+}
+
+static void qskDeleteChildNode( QSGNode* parentNode, QSGNode* node )
+{
+    parentNode->removeChildNode( node );
+
+    if ( node->flags() & QSGNode::OwnedByParent )
+        QskNodePool::release( node );
 }
 
 static inline void qskInsertRemoveChild( QSGNode* parentNode,
@@ -34,11 +81,7 @@ static inline void qskInsertRemoveChild( QSGNode* parentNode,
         return;
 
     if ( oldNode )
-    {
-        parentNode->removeChildNode( oldNode );
-        if ( oldNode->flags() & QSGNode::OwnedByParent )
-            delete oldNode;
-    }
+        qskDeleteChildNode( parentNode, oldNode );
 
     if ( newNode )
     {
@@ -187,36 +230,28 @@ QSGNode* QskScaleRenderer::updateLabelsNode(
     if ( ticks.isEmpty() )
         return nullptr;
 
-    if( node == nullptr )
-        node = new QSGNode;
-
     const QFontMetricsF fm( m_data->font );
 
     const qreal length = ( m_data->orientation == Qt::Horizontal )
         ? tickmarksRect.width() : tickmarksRect.height();
     const qreal ratio = length / m_data->boundaries.width();
 
-    auto nextNode = node->firstChild();
+    QVector< Label > labels;
+    labels.reserve( ticks.count() );
 
     QRectF labelRect;
 
     for ( auto tick : ticks )
     {
-        enum LabelNodeRole
-        {
-            TextNode = 1,
-            GraphicNode = 2
-        };
-
-        const auto label = labelAt( tick );
-        if ( label.isNull() )
+        const auto value = labelAt( tick );
+        if ( value.isNull() )
             continue;
 
         const qreal tickPos = ratio * ( tick - m_data->boundaries.lowerBound() );
 
-        if ( label.canConvert< QString >() )
+        if ( value.canConvert< QString >() )
         {
-            auto text = label.toString();
+            const auto text = value.toString();
             if ( text.isEmpty() )
                 continue;
 
@@ -254,51 +289,29 @@ QSGNode* QskScaleRenderer::updateLabelsNode(
                 alignment = Qt::AlignRight;
             }
 
-            if ( nextNode && QskSGNode::nodeRole( nextNode ) != TextNode )
-            {
-                nextNode = qskRemoveTraillingNodes( node, nextNode );
-            }
-
             if ( !labelRect.isEmpty() && labelRect.intersects( r ) )
             {
                 if ( tick != ticks.last() )
-                {
-                    text = QString();
-                }
-                else
-                {
-                    if ( auto obsoleteNode = nextNode
-                        ? nextNode->previousSibling() : node->lastChild() )
-                    {
-                        node->removeChildNode( obsoleteNode );
-                        if ( obsoleteNode->flags() & QSGNode::OwnedByParent )
-                            delete obsoleteNode;
-                    }
-
-                    labelRect = r;
-                }
-            }
-            else
-            {
-                labelRect = r;
-            }
+                    continue;
 
-            if ( nextNode == nullptr )
-            {
-                nextNode = new QskTextNode;
-                QskSGNode::setNodeRole( nextNode, TextNode );
-                node->appendChildNode( nextNode );
+                // the last label is always displayed
+                if ( !labels.isEmpty() )
+                    labels.removeLast();
             }
 
-            auto textNode = static_cast< QskTextNode* >( nextNode );
-            textNode->setTextData( skinnable->owningControl(), text, r, m_data->font,
-                QskTextOptions(), m_data->textColors, alignment, Qsk::Normal );
+            labelRect = r;
 
-            nextNode = nextNode->nextSibling();
+            Label label;
+            label.tick = tick;
+            label.text = text;
+            label.rect = r;
+            label.alignment = alignment;
+
+            labels += label;
         }
-        else if ( label.canConvert< QskGraphic >() )
+        else if ( value.canConvert< QskGraphic >() )
         {
-            const auto graphic = label.value< QskGraphic >();
+            const auto graphic = value.value< QskGraphic >();
             if ( graphic.isNull() )
                 continue;
 
@@ -324,31 +337,92 @@ QSGNode* QskScaleRenderer::updateLabelsNode(
                 alignment = Qt::AlignRight | Qt::AlignVCenter;
             }
 
-            if ( nextNode && QskSGNode::nodeRole( nextNode ) != GraphicNode )
-            {
-                nextNode = qskRemoveTraillingNodes( node, nextNode );
-            }
+            Label label;
+            label.tick = tick;
+            label.graphic = graphic;
+            label.rect = labelRect;
+            label.alignment = alignment;
+
+            labels += label;
+        }
+    }
+
+    auto labelsNode = static_cast< LabelsNode* >( node );
+    if ( labelsNode == nullptr )
+        labelsNode = new LabelsNode();
+
+    /*
+        Label nodes are identified by their tick value. When scrolling
+        most ticks survive an update and the nodes of their labels only
+        need to be moved. Only labels, that become visible, are created.
+     */
+    auto oldNodes = labelsNode->labelNodes;
+    labelsNode->labelNodes.clear();
+
+    const qreal epsilon = 1e-9 * qAbs( m_data->boundaries.width() );
+
+    for ( const auto& label : qAsConst( labels ) )
+    {
+        if ( labelsNode->labelNodes.contains( label.tick ) )
+            continue;
+
+        auto oldNode = qskTakeLabelNode( oldNodes, label.tick, epsilon );
+
+        QSGNode* newNode = nullptr;
 
-            if ( nextNode == nullptr )
+        if ( label.graphic.isNull() )
+        {
+            QskTextNode* textNode = nullptr;
+            if ( oldNode && QskSGNode::nodeRole( oldNode ) == TextNode )
+                textNode = static_cast< QskTextNode* >( oldNode );
+
+            if ( textNode == nullptr )
             {
-                nextNode = new QskGraphicNode;
-                QskSGNode::setNodeRole( nextNode, GraphicNode );
-                node->appendChildNode( nextNode );
+                textNode = QskNodePool::createTextNode();
+                QskSGNode::setNodeRole( textNode, TextNode );
             }
 
-            auto graphicNode = static_cast< QskGraphicNode* >( nextNode );
+            // a label, that has only been moved, does not need to be layouted again
+            textNode->setTextData( skinnable->owningControl(), label.text, label.rect,
+                m_data->font, QskTextOptions(), m_data->textColors,
+                label.alignment, Qsk::Normal );
 
-            QskSkinlet::updateGraphicNode(
-                skinnable->owningControl(), graphicNode,
-                graphic, m_data->colorFilter, labelRect, alignment );
+            newNode = textNode;
+        }
+        else
+        {
+            QSGNode* graphicNode = nullptr;
+            if ( oldNode && QskSGNode::nodeRole( oldNode ) == GraphicNode )
+                graphicNode = oldNode;
+
+            /*
+                Depending on the update flags of the control the graphic
+                might be displayed by a different type of node
+             */
+            newNode = QskSkinlet::updateGraphicNode(
+                skinnable->owningControl(), graphicNode, label.graphic,
+                m_data->colorFilter, label.rect, label.alignment );
+
+            if ( newNode )
+                QskSGNode::setNodeRole( newNode, GraphicNode );
+        }
 
-            nextNode = nextNode->nextSibling();
+        if ( oldNode && oldNode != newNode )
+            qskDeleteChildNode( labelsNode, oldNode );
+
+        if ( newNode )
+        {
+            if ( newNode->parent() == nullptr )
+                labelsNode->appendChildNode( newNode );
+
+            labelsNode->labelNodes.insert( label.tick, newNode );
         }
     }
 
-    qskRemoveTraillingNodes( node, nextNode );
+    for ( auto it = oldNodes.constBegin(); it != oldNodes.constEnd(); ++it )
+        qskDeleteChildNode( labelsNode, it.value() );
 
-    return node;
+    return labelsNode;
 }
 
 QVariant QskScaleRenderer::labelAt( qreal pos ) const
@@ -0,0 +1,417 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskTextureAtlas.h"
+#include "QskWindowResourceMap.h"
+
+#include <qglobalstatic.h>
+#include <qimage.h>
+#include <qopenglcontext.h>
+#include <qopenglfunctions.h>
+#include <qopengltexture.h>
+#include <qquickwindow.h>
+#include <qvector.h>
+
+/*
+    Small enough to be allocated without noticeable costs, big enough
+    for all icons of a typical window.
+ */
+static const int qskPageSize = 1024;
+static const int qskMaxEntrySize = 128;
+static const int qskMaxPageCount = 4;
+
+// avoiding artifacts from neighbouring entries
+static const int qskPadding = 1;
+
+using AtlasMap = QskWindowResourceMap< QskTextureAtlas >;
+
+Q_GLOBAL_STATIC( AtlasMap, qskAtlasMap )
+
+static inline bool qskIsAtlasSupported( const QQuickWindow* window )
+{
+    if ( window == nullptr || QOpenGLContext::currentContext() == nullptr )
+        return false;
+
+    const auto renderer = window->rendererInterface();
+    return renderer->graphicsApi() == QSGRendererInterface::OpenGL;
+}
+
+namespace
+{
+    class Slot
+    {
+      public:
+        int x;
+        int width;
+    };
+
+    class Shelf
+    {
+      public:
+        int y = 0;
+        int height = 0;
+        int x = 0; // start of the unused space at the end
+
+        int entryCount = 0;
+        QVector< Slot > freeSlots;
+
+        int allocate( int width )
+        {
+            for ( int i = 0; i < freeSlots.count(); i++ )
+            {
+                auto& slot = freeSlots[ i ];
+                if ( slot.width >= width )
+                {
+                    const int pos = slot.x;
+
+                    slot.x += width;
+                    slot.width -= width;
+
+                    if ( slot.width == 0 )
+                        freeSlots.remove( i );
+
+                    return pos;
+                }
+            }
+
+            if ( x + width <= qskPageSize )
+            {
+                const int pos = x;
+                x += width;
+
+                return pos;
+            }
+
+            return -1;
+        }
+
+        void release( int pos, int width )
+        {
+            if ( --entryCount == 0 )
+            {
+                x = 0;
+                freeSlots.clear();
+            }
+            else if ( pos + width == x )
+            {
+                x = pos;
+            }
+            else
+            {
+                freeSlots += Slot { pos, width };
+            }
+        }
+    };
+
+    class Page
+    {
+      public:
+        void reset()
+        {
+            shelves.clear();
+            y = 0;
+        }
+
+        uint textureId = 0;
+        int entryCount = 0;
+        int y = 0; // start of the unused space at the bottom
+
+        QVector< Shelf > shelves;
+    };
+}
+
+static uint qskCreatePageTexture()
+{
+    auto& f = *QOpenGLContext::currentContext()->functions();
+
+    const auto target = QOpenGLTexture::Target2D;
+
+    GLint oldTexture;
+    f.glGetIntegerv( QOpenGLTexture::BindingTarget2D, &oldTexture );
+
+    GLuint textureId;
+    f.glGenTextures( 1, &textureId );
+
+    f.glBindTexture( target, textureId );
+
+    f.glTexParameteri( target, GL_TEXTURE_MIN_FILTER, QOpenGLTexture::Nearest );
+    f.glTexParameteri( target, GL_TEXTURE_MAG_FILTER, QOpenGLTexture::Nearest );
+
+    f.glTexParameteri( target, GL_TEXTURE_WRAP_S, QOpenGLTexture::ClampToEdge );
+    f.glTexParameteri( target, GL_TEXTURE_WRAP_T, QOpenGLTexture::ClampToEdge );
+
+    f.glTexImage2D( target, 0, QOpenGLTexture::RGBA8_UNorm,
+        qskPageSize, qskPageSize, 0,
+        QOpenGLTexture::RGBA, QOpenGLTexture::UInt8, nullptr );
+
+    f.glBindTexture( target, oldTexture );
+
+    return textureId;
+}
+
+static void qskUploadImage( uint textureId, const QPoint& pos, const QImage& image )
+{
+    auto& f = *QOpenGLContext::currentContext()->functions();
+
+    const auto target = QOpenGLTexture::Target2D;
+
+    GLint oldTexture;
+    f.glGetIntegerv( QOpenGLTexture::BindingTarget2D, &oldTexture );
+
+    f.glBindTexture( target, textureId );
+
+    f.glTexSubImage2D( target, 0, pos.x(), pos.y(),
+        image.width(), image.height(),
+        QOpenGLTexture::RGBA, QOpenGLTexture::UInt8, image.constBits() );
+
+    f.glBindTexture( target, oldTexture );
+}
+
+static void qskDeletePageTexture( uint textureId )
+{
+    // at program termination the context might already be gone
+    if ( auto context = QOpenGLContext::currentContext() )
+    {
+        GLuint id = textureId;
+        context->functions()->glDeleteTextures( 1, &id );
+    }
+}
+
+class QskTextureAtlas::PrivateData
+{
+  public:
+    bool allocate( int pageIndex, int width, int height, Entry& entry )
+    {
+        auto& page = pages[ pageIndex ];
+
+        const int w = width + qskPadding;
+        const int h = height + qskPadding;
+
+        for ( int i = 0; i < page.shelves.count(); i++ )
+        {
+            auto& shelf = page.shelves[ i ];
+
+            /*
+                Avoid wasting space by putting small entries
+                into much higher shelves
+             */
+            if ( h > shelf.height || ( shelf.entryCount > 0 && 2 * h < shelf.height ) )
+                continue;
+
+            const int x = shelf.allocate( w );
+            if ( x >= 0 )
+            {
+                shelf.entryCount++;
+                page.entryCount++;
+
+                entry.rect = QRect( x, shelf.y, width, height );
+                entry.page = pageIndex;
+                entry.shelf = i;
+
+                return true;
+            }
+        }
+
+        if ( page.y + h > qskPageSize )
+            return false;
+
+        Shelf shelf;
+        shelf.y = page.y;
+        shelf.height = h;
+        shelf.x = w;
+        shelf.entryCount = 1;
+
+        page.shelves += shelf;
+        page.y += h;
+        page.entryCount++;
+
+        entry.rect = QRect( 0, shelf.y, width, height );
+        entry.page = pageIndex;
+        entry.shelf = page.shelves.count() - 1;
+
+        return true;
+    }
+
+    QVector< Page > pages;
+};
+
+QskTextureAtlas::QskTextureAtlas()
+    : m_data( new PrivateData() )
+{
+}
+
+QskTextureAtlas::~QskTextureAtlas()
+{
+    for ( const auto& page : qAsConst( m_data->pages ) )
+    {
+        if ( page.textureId )
+            qskDeletePageTexture( page.textureId );
+    }
+}
+
+QskTextureAtlas* QskTextureAtlas::atlas( QQuickWindow* window )
+{
+    if ( !qskIsAtlasSupported( window ) )
+        return nullptr;
+
+    return qskAtlasMap->resource( window );
+}
+
+bool QskTextureAtlas::isCandidate( const QSize& size )
+{
+    return !size.isEmpty() &&
+        ( size.width() <= qskMaxEntrySize ) && ( size.height() <= qskMaxEntrySize );
+}
+
+QskTextureAtlas::Entry QskTextureAtlas::insert( const QImage& image )
+{
+    Entry entry;
+
+    if ( !isCandidate( image.size() ) )
+        return entry;
+
+    Q_ASSERT( image.format() == QImage::Format_RGBA8888_Premultiplied );
+
+    auto& pages = m_data->pages;
+
+    bool found = false;
+
+    for ( int i = 0; !found && i < pages.count(); i++ )
+    {
+        if ( pages[ i ].textureId > 0 )
+            found = m_data->allocate( i, image.width(), image.height(), entry );
+    }
+
+    if ( !found )
+    {
+        // reusing the slot of a discarded page or appending a new one
+
+        int index = -1;
+        for ( int i = 0; i < pages.count(); i++ )
+        {
+            if ( pages[ i ].textureId == 0 )
+            {
+                index = i;
+                break;
+            }
+        }
+
+        if ( index < 0 )
+        {
+            if ( pages.count() >= qskMaxPageCount )
+                return entry;
+
+            pages += Page();
+            index = pages.count() - 1;
+        }
+
+        pages[ index ].textureId = qskCreatePageTexture();
+        found = m_data->allocate( index, image.width(), image.height(), entry );
+    }
+
+    if ( found )
+    {
+        entry.atlas = this;
+        entry.textureId = pages[ entry.page ].textureId;
+        entry.textureSize = QSize( qskPageSize, qskPageSize );
+
+        qskUploadImage( entry.textureId, entry.rect.topLeft(), image );
+    }
+
+    return entry;
+}
+
+void QskTextureAtlas::remove( const Entry& entry )
+{
+    auto& pages = m_data->pages;
+
+    if ( entry.page < 0 || entry.page >= pages.count() )
+        return;
+
+    auto& page = pages[ entry.page ];
+
+    if ( page.textureId != entry.textureId )
+        return;
+
+    Q_ASSERT( entry.shelf >= 0 && entry.shelf < page.shelves.count() );
+
+    const int w = entry.rect.width() + qskPadding;
+
+    auto& shelf = page.shelves[ entry.shelf ];
+    shelf.release( entry.rect.x(), w );
+
+    if ( --page.entryCount == 0 )
+    {
+        /*
+            Repacking an empty page. As the first page will be
+            needed again soon we keep its texture.
+         */
+        page.reset();
+
+        if ( entry.page > 0 )
+        {
+            qskDeletePageTexture( page.textureId );
+            page.textureId = 0;
+        }
+    }
+    else if ( shelf.entryCount == 0 && entry.shelf == page.shelves.count() - 1 )
+    {
+        // giving the space of trailing empty shelves back to the page
+
+        while ( !page.shelves.isEmpty() && page.shelves.last().entryCount == 0 )
+        {
+            page.y = page.shelves.last().y;
+            page.shelves.removeLast();
+        }
+    }
+}
+
+void QskTextureAtlas::release( Entry& entry )
+{
+    // at program termination the map might already be gone
+    if ( entry.atlas && !qskAtlasMap.isDestroyed() )
+    {
+        QMutexLocker locker( qskAtlasMap->mutex() );
+
+        if ( qskAtlasMap->contains( entry.atlas ) )
+            entry.atlas->remove( entry );
+    }
+
+    entry = Entry();
+}
+
+int QskTextureAtlas::pageCount() const
+{
+    int count = 0;
+
+    for ( const auto& page : qAsConst( m_data->pages ) )
+    {
+        if ( page.textureId )
+            count++;
+    }
+
+    return count;
+}
+
+int QskTextureAtlas::entryCount() const
+{
+    int count = 0;
+
+    for ( const auto& page : qAsConst( m_data->pages ) )
+        count += page.entryCount;
+
+    return count;
+}
+
+QRectF QskTextureAtlas::Entry::textureRect() const
+{
+    if ( textureSize.isEmpty() )
+        return QRectF();
+
+    const qreal w = textureSize.width();
+    const qreal h = textureSize.height();
+
+    return QRectF( rect.x() / w, rect.y() / h, rect.width() / w, rect.height() / h );
+}
@@ -0,0 +1,77 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_TEXTURE_ATLAS_H
+#define QSK_TEXTURE_ATLAS_H
+
+#include "QskGlobal.h"
+
+#include <qrect.h>
+#include <memory>
+
+class QImage;
+class QQuickWindow;
+
+/*
+    A per window texture atlas for small images, so that many nodes can share
+    the same texture and material. This allows the scene graph renderer
+    to batch them.
+
+    The atlas consists of pages - textures of a fixed size - that are
+    filled by shelf packing. Entries are released by their nodes. Space of
+    released entries is reused and a page without entries is repacked from scratch.
+
+    The atlas is only available for the OpenGL backend.
+ */
+class QSK_EXPORT QskTextureAtlas
+{
+  public:
+    class Entry
+    {
+      public:
+        inline bool isValid() const { return textureId > 0; }
+
+        // normalized coordinates of rect inside of the texture
+        QRectF textureRect() const;
+
+        uint textureId = 0;
+        QRect rect;
+        QSize textureSize;
+
+      private:
+        friend class QskTextureAtlas;
+
+        QskTextureAtlas* atlas = nullptr;
+        int page = -1;
+        int shelf = -1;
+    };
+
+    QskTextureAtlas();
+    ~QskTextureAtlas();
+
+    // nullptr, when not supported by the scene graph backend
+    static QskTextureAtlas* atlas( QQuickWindow* );
+
+    // size in device pixels
+    static bool isCandidate( const QSize& );
+
+    // resets entry, also when the atlas has already been destroyed
+    static void release( Entry& );
+
+    Entry insert( const QImage& );
+
+    int pageCount() const;
+    int entryCount() const;
+
+  private:
+    Q_DISABLE_COPY( QskTextureAtlas )
+
+    void remove( const Entry& );
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
@@ -0,0 +1,325 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskTextureCache.h"
+#include "QskTexturePool.h"
+#include "QskWindowResourceMap.h"
+
+#include <qglobalstatic.h>
+#include <qhash.h>
+#include <qopenglcontext.h>
+
+static QAtomicInteger< qint64 > qskMemoryBudget( 32 * 1024 * 1024 );
+
+using CacheMap = QskWindowResourceMap< QskTextureCache >;
+
+Q_GLOBAL_STATIC( CacheMap, qskCacheMap )
+
+static inline QskHashValue qHash( const QskTextureCache::Key& key, QskHashValue seed = 0 )
+{
+    auto hash = qHash( key.graphicHash, seed );
+    hash = qHash( key.colorFilterHash, hash );
+    hash = qHash( key.size.width(), hash );
+    hash = qHash( key.size.height(), hash );
+    hash = qHash( key.devicePixelRatio, hash );
+
+    return qHash( key.renderMode, hash );
+}
+
+namespace
+{
+    class Entry
+    {
+      public:
+        uint textureId = 0;
+        QRectF textureRect;
+
+        QskTextureAtlas::Entry atlasEntry;
+
+        qint64 bytes = 0;
+        int refCount = 0;
+
+        quint64 lastUsed = 0; // for finding the least recently used entries
+    };
+}
+
+class QskTextureCache::PrivateData
+{
+  public:
+    void removeEntry( Entry& entry )
+    {
+        if ( entry.atlasEntry.isValid() )
+            QskTextureAtlas::release( entry.atlasEntry );
+        else
+            QskTexturePool::releaseTexture( entry.textureId );
+
+        memoryUsage -= entry.bytes;
+    }
+
+    Handle addEntry( const Key& key, Entry& entry )
+    {
+        entry.refCount = 1;
+        entry.lastUsed = ++usageCounter;
+
+        memoryUsage += entry.bytes;
+        entries.insert( key, entry );
+
+        Handle handle;
+        handle.textureId = entry.textureId;
+        handle.textureRect = entry.textureRect;
+
+        return handle;
+    }
+
+    mutable QMutex mutex;
+
+    QHash< Key, Entry > entries;
+
+    qint64 memoryUsage = 0;
+    quint64 usageCounter = 0;
+
+    quint64 hits = 0;
+    quint64 misses = 0;
+    quint64 evictions = 0;
+};
+
+QskTextureCache::Key::Key( QskHashValue graphicHash,
+        QskHashValue colorFilterHash, const QSize& size,
+        qreal devicePixelRatio, int renderMode )
+    : graphicHash( graphicHash )
+    , colorFilterHash( colorFilterHash )
+    , size( size )
+    , devicePixelRatio( devicePixelRatio )
+    , renderMode( renderMode )
+{
+}
+
+bool QskTextureCache::Key::operator==( const Key& other ) const
+{
+    return ( graphicHash == other.graphicHash )
+        && ( colorFilterHash == other.colorFilterHash )
+        && ( size == other.size ) && ( devicePixelRatio == other.devicePixelRatio )
+        && ( renderMode == other.renderMode );
+}
+
+QskTextureCache::QskTextureCache()
+    : m_data( new PrivateData() )
+{
+}
+
+QskTextureCache::~QskTextureCache()
+{
+    for ( auto it = m_data->entries.begin(); it != m_data->entries.end(); ++it )
+        m_data->removeEntry( it.value() );
+}
+
+QskTextureCache* QskTextureCache::cache( QQuickWindow* window )
+{
+    if ( window == nullptr || QOpenGLContext::currentContext() == nullptr )
+        return nullptr;
+
+    const auto renderer = window->rendererInterface();
+    if ( renderer->graphicsApi() != QSGRendererInterface::OpenGL )
+        return nullptr;
+
+    return qskCacheMap->resource( window );
+}
+
+void QskTextureCache::setMemoryBudget( qint64 bytes )
+{
+    qskMemoryBudget = qMax( bytes, qint64( 0 ) );
+}
+
+qint64 QskTextureCache::memoryBudget()
+{
+    return qskMemoryBudget;
+}
+
+QskTextureCache::Statistics QskTextureCache::globalStatistics()
+{
+    Statistics statistics;
+
+    QMutexLocker locker( qskCacheMap->mutex() );
+
+    const auto caches = qskCacheMap->resources();
+    for ( const auto cache : caches )
+    {
+        const auto s = cache->statistics();
+
+        statistics.entryCount += s.entryCount;
+        statistics.unusedCount += s.unusedCount;
+        statistics.memoryUsage += s.memoryUsage;
+        statistics.hits += s.hits;
+        statistics.misses += s.misses;
+        statistics.evictions += s.evictions;
+    }
+
+    return statistics;
+}
+
+void QskTextureCache::release( Handle& handle )
+{
+    // at program termination the map might already be gone
+    if ( handle.cache && !qskCacheMap.isDestroyed() )
+    {
+        QMutexLocker locker( qskCacheMap->mutex() );
+
+        if ( qskCacheMap->contains( handle.cache ) )
+            handle.cache->unref( handle.key );
+    }
+
+    handle = Handle();
+}
+
+QskTextureCache::Handle QskTextureCache::acquire( const Key& key )
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    Handle handle;
+
+    auto it = m_data->entries.find( key );
+    if ( it == m_data->entries.end() )
+    {
+        m_data->misses++;
+        return handle;
+    }
+
+    auto& entry = it.value();
+
+    entry.refCount++;
+    entry.lastUsed = ++m_data->usageCounter;
+
+    m_data->hits++;
+
+    handle.cache = this;
+    handle.key = key;
+    handle.textureId = entry.textureId;
+    handle.textureRect = entry.textureRect;
+
+    return handle;
+}
+
+QskTextureCache::Handle QskTextureCache::insert(
+    const Key& key, uint textureId, const QSize& textureSize )
+{
+    Handle handle;
+
+    if ( textureId == 0 )
+        return handle;
+
+    QMutexLocker locker( &m_data->mutex );
+
+    Q_ASSERT( !m_data->entries.contains( key ) );
+
+    Entry entry;
+    entry.textureId = textureId;
+    entry.textureRect = QRectF( 0.0, 0.0, 1.0, 1.0 );
+    entry.bytes = 4 * qint64( textureSize.width() ) * textureSize.height();
+
+    handle = m_data->addEntry( key, entry );
+    handle.cache = this;
+    handle.key = key;
+
+    trim();
+
+    return handle;
+}
+
+QskTextureCache::Handle QskTextureCache::insert(
+    const Key& key, const QskTextureAtlas::Entry& atlasEntry )
+{
+    Handle handle;
+
+    if ( !atlasEntry.isValid() )
+        return handle;
+
+    QMutexLocker locker( &m_data->mutex );
+
+    Q_ASSERT( !m_data->entries.contains( key ) );
+
+    Entry entry;
+    entry.textureId = atlasEntry.textureId;
+    entry.textureRect = atlasEntry.textureRect();
+    entry.atlasEntry = atlasEntry;
+    entry.bytes = 4 * qint64( atlasEntry.rect.width() ) * atlasEntry.rect.height();
+
+    handle = m_data->addEntry( key, entry );
+    handle.cache = this;
+    handle.key = key;
+
+    trim();
+
+    return handle;
+}
+
+void QskTextureCache::unref( const Key& key )
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    auto it = m_data->entries.find( key );
+    if ( it != m_data->entries.end() )
+    {
+        auto& entry = it.value();
+        if ( --entry.refCount <= 0 )
+        {
+            entry.refCount = 0;
+            trim();
+        }
+    }
+}
+
+void QskTextureCache::trim()
+{
+    // called with locked mutex
+
+    const auto budget = memoryBudget();
+
+    auto& entries = m_data->entries;
+
+    while ( m_data->memoryUsage > budget )
+    {
+        auto lru = entries.end();
+
+        for ( auto it = entries.begin(); it != entries.end(); ++it )
+        {
+            const auto& entry = it.value();
+
+            if ( entry.refCount == 0 )
+            {
+                if ( lru == entries.end() || entry.lastUsed < lru.value().lastUsed )
+                    lru = it;
+            }
+        }
+
+        if ( lru == entries.end() )
+            break; // all textures are in use
+
+        m_data->removeEntry( lru.value() );
+        entries.erase( lru );
+
+        m_data->evictions++;
+    }
+}
+
+QskTextureCache::Statistics QskTextureCache::statistics() const
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    Statistics statistics;
+
+    statistics.entryCount = m_data->entries.count();
+    statistics.memoryUsage = m_data->memoryUsage;
+    statistics.hits = m_data->hits;
+    statistics.misses = m_data->misses;
+    statistics.evictions = m_data->evictions;
+
+    for ( auto it = m_data->entries.constBegin(); it != m_data->entries.constEnd(); ++it )
+    {
+        if ( it.value().refCount == 0 )
+            statistics.unusedCount++;
+    }
+
+    return statistics;
+}
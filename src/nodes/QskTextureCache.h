@@ -0,0 +1,106 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_TEXTURE_CACHE_H
+#define QSK_TEXTURE_CACHE_H
+
+#include "QskGlobal.h"
+#include "QskTextureAtlas.h"
+
+#include <qrect.h>
+#include <memory>
+
+class QQuickWindow;
+
+/*
+    A per window cache for textures, that have been rasterized from the same
+    graphic, color filter, size, device pixel ratio and render mode. The textures are reference
+    counted and shared between the nodes displaying them.
+
+    Textures, that are not in use anymore, are kept until the memory
+    budget is exceeded. Then the least recently used ones are removed.
+ */
+class QSK_EXPORT QskTextureCache
+{
+  public:
+    class Key
+    {
+      public:
+        Key() = default;
+        Key( QskHashValue graphicHash, QskHashValue colorFilterHash,
+            const QSize& size, qreal devicePixelRatio, int renderMode );
+
+        bool operator==( const Key& ) const;
+        inline bool operator!=( const Key& other ) const { return !( *this == other ); }
+
+        QskHashValue graphicHash = 0;
+        QskHashValue colorFilterHash = 0;
+        QSize size; // in logical pixels
+        qreal devicePixelRatio = 1.0;
+        int renderMode = 0;
+    };
+
+    class Handle
+    {
+      public:
+        inline bool isValid() const { return textureId > 0; }
+
+        uint textureId = 0;
+        QRectF textureRect;
+
+      private:
+        friend class QskTextureCache;
+
+        QskTextureCache* cache = nullptr;
+        Key key;
+    };
+
+    class Statistics
+    {
+      public:
+        int entryCount = 0;
+        int unusedCount = 0;
+        qint64 memoryUsage = 0; // bytes
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+    };
+
+    QskTextureCache();
+    ~QskTextureCache();
+
+    // nullptr, when not supported by the scene graph backend
+    static QskTextureCache* cache( QQuickWindow* );
+
+    // unused textures are removed, when exceeding the budget
+    static void setMemoryBudget( qint64 bytes );
+    static qint64 memoryBudget();
+
+    // accumulated over the caches of all windows
+    static Statistics globalStatistics();
+
+    // resets handle, also when the cache has already been destroyed
+    static void release( Handle& );
+
+    Handle acquire( const Key& );
+
+    // the cache takes ownership of the texture
+    Handle insert( const Key&, uint textureId, const QSize& textureSize );
+    Handle insert( const Key&, const QskTextureAtlas::Entry& );
+
+    Statistics statistics() const;
+
+  private:
+    Q_DISABLE_COPY( QskTextureCache )
+
+    void unref( const Key& );
+    void trim();
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
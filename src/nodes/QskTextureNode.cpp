@@ -1,5 +1,6 @@
 #include "QskTextureNode.h"
 #include "QskFunctions.h"
+#include "QskTexturePool.h"
 
 #include <qopenglfunctions.h>
 #include <qsggeometry.h>
@@ -21,7 +22,8 @@ QSK_QT_PRIVATE_BEGIN
 #include <private/qrhigles2_p_p.h>
 QSK_QT_PRIVATE_END
 
-static void qskUpdateGLTextureId( QRhiTexture* rhiTexture, uint textureId )
+static void qskUpdateGLTextureId(
+    QRhiTexture* rhiTexture, uint textureId, bool deleteOld )
 {
     // hack time: we do not want to create a new QSGTexture object for each texture
 
@@ -32,13 +34,10 @@ static void qskUpdateGLTextureId( QRhiTexture* rhiTexture, uint textureId )
         // ...
     };
 
-    GLuint id = rhiTexture->nativeTexture().object;
+    const GLuint id = rhiTexture->nativeTexture().object;
 
-    if ( id )
-    {
-        auto funcs = QOpenGLContext::currentContext()->functions();
-        funcs->glDeleteTextures( 1, &id );
-    }
+    if ( id && deleteOld )
+        QskTexturePool::releaseTexture( id );
 
     auto glTexture = static_cast< Texture* >( rhiTexture );
     glTexture->texture = textureId;
@@ -209,20 +208,11 @@ namespace
 
 static inline void qskDeleteTexture( const TextureMaterial& material )
 {
-    if ( material.textureId() > 0 )
-    {
-        /*
-            In certain environments we have the effect, that at
-            program termination the context is already gone
-         */
-        if ( auto context = QOpenGLContext::currentContext() )
-        {
-            GLuint id = material.textureId();
-
-            auto funcs = context->functions();
-            funcs->glDeleteTextures( 1, &id );
-        }
-    }
+    /*
+        Frequently updated nodes create textures of the same size
+        over and over. So we give them back to the pool for being recycled.
+     */
+    QskTexturePool::releaseTexture( material.textureId() );
 }
 
 #endif
@@ -239,18 +229,18 @@ class QskTextureNodePrivate final : public QSGGeometryNodePrivate
 
     void updateTextureGeometry()
     {
-        QRectF r( 0, 0, 1, 1 );
+        QRectF r = textureRect;
 
         if ( this->mirrored & Qt::Horizontal )
         {
-            r.setLeft( 1 );
-            r.setRight( 0 );
+            r.setLeft( textureRect.right() );
+            r.setRight( textureRect.left() );
         }
 
         if ( mirrored & Qt::Vertical )
         {
-            r.setTop( 1 );
-            r.setBottom( 0 );
+            r.setTop( textureRect.bottom() );
+            r.setBottom( textureRect.top() );
         }
 
         QSGGeometry::updateTexturedRectGeometry( &geometry, rect, r );
@@ -262,7 +252,10 @@ class QskTextureNodePrivate final : public QSGGeometryNodePrivate
     TextureMaterial material;
 
     QRectF rect;
+    QRectF textureRect = QRectF( 0.0, 0.0, 1.0, 1.0 );
     Qt::Orientations mirrored;
+
+    bool isShared = false;
 };
 
 QskTextureNode::QskTextureNode()
@@ -279,18 +272,41 @@ QskTextureNode::QskTextureNode()
 QskTextureNode::~QskTextureNode()
 {
     Q_D( const QskTextureNode );
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+    if ( d->isShared )
+        return;
+#endif
+
     qskDeleteTexture( d->material );
 }
 
 void QskTextureNode::setTexture( QQuickWindow* window,
     const QRectF& rect, uint textureId,
     Qt::Orientations mirrored )
+{
+    setTextureData( window, rect, textureId,
+        QRectF( 0.0, 0.0, 1.0, 1.0 ), false, mirrored );
+}
+
+void QskTextureNode::setSharedTexture( QQuickWindow* window,
+    const QRectF& rect, uint textureId, const QRectF& textureRect,
+    Qt::Orientations mirrored )
+{
+    setTextureData( window, rect, textureId, textureRect, true, mirrored );
+}
+
+void QskTextureNode::setTextureData( QQuickWindow* window,
+    const QRectF& rect, uint textureId, const QRectF& textureRect,
+    bool isShared, Qt::Orientations mirrored )
 {
     Q_D( QskTextureNode );
 
-    if ( ( d->rect != rect ) || ( d->mirrored != mirrored ) )
+    if ( ( d->rect != rect ) || ( d->mirrored != mirrored )
+        || ( d->textureRect != textureRect ) )
     {
         d->rect = rect;
+        d->textureRect = textureRect;
         d->mirrored = mirrored;
 
         d->updateTextureGeometry();
@@ -302,13 +318,16 @@ void QskTextureNode::setTexture( QQuickWindow* window,
         d->setTextureId( window, textureId );
         markDirty( DirtyMaterial );
     }
+
+    d->isShared = isShared;
 }
 
 #if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
 
 void QskTextureNodePrivate::setTextureId( QQuickWindow*, uint textureId )
 {
-    qskDeleteTexture( this->material );
+    if ( !this->isShared )
+        qskDeleteTexture( this->material );
 
     this->material.setTextureId( textureId );
     this->opaqueMaterial.setTextureId( textureId );
@@ -337,7 +356,8 @@ void QskTextureNodePrivate::setTextureId( QQuickWindow* window, uint textureId )
         {
             case QSGRendererInterface::OpenGL:
             {
-                qskUpdateGLTextureId( texture->rhiTexture(), textureId );
+                qskUpdateGLTextureId( texture->rhiTexture(),
+                    textureId, !this->isShared );
                 break;
             }
             default:
@@ -386,8 +406,20 @@ QRectF QskTextureNode::rect() const
     return d->rect;
 }
 
+QRectF QskTextureNode::textureRect() const
+{
+    Q_D( const QskTextureNode );
+    return d->textureRect;
+}
+
 Qt::Orientations QskTextureNode::mirrored() const
 {
     Q_D( const QskTextureNode );
     return d->mirrored;
 }
+
+bool QskTextureNode::isTextureShared() const
+{
+    Q_D( const QskTextureNode );
+    return d->isShared;
+}
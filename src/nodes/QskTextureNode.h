@@ -25,11 +25,24 @@ class QSK_EXPORT QskTextureNode : public QSGGeometryNode
     void setTexture( QQuickWindow*, const QRectF&, uint id,
         Qt::Orientations mirrored = Qt::Orientations() );
 
+    /*
+        A texture, that is not owned by the node - f.e. an atlas. textureRect
+        is the normalized sub-rectangle of the texture to be displayed.
+     */
+    void setSharedTexture( QQuickWindow*, const QRectF&, uint id,
+        const QRectF& textureRect, Qt::Orientations mirrored = Qt::Orientations() );
+
     uint textureId() const;
     QRectF rect() const;
+    QRectF textureRect() const;
     Qt::Orientations mirrored() const;
 
+    bool isTextureShared() const;
+
   private:
+    void setTextureData( QQuickWindow*, const QRectF&, uint id,
+        const QRectF& textureRect, bool isShared, Qt::Orientations );
+
     Q_DECLARE_PRIVATE( QskTextureNode )
 };
 
@@ -0,0 +1,395 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskTexturePool.h"
+#include "QskWindowResourceMap.h"
+
+#include <qglobalstatic.h>
+#include <qhash.h>
+#include <qopenglcontext.h>
+#include <qopenglframebufferobject.h>
+#include <qopenglfunctions.h>
+#include <qopengltexture.h>
+#include <qvector.h>
+
+static QAtomicInteger< qint64 > qskMemoryBudget( 16 * 1024 * 1024 );
+
+using PoolMap = QskWindowResourceMap< QskTexturePool >;
+
+Q_GLOBAL_STATIC( PoolMap, qskPoolMap )
+
+static inline qint64 qskTextureBytes( const QSize& size )
+{
+    return 4 * qint64( size.width() ) * size.height();
+}
+
+static inline qint64 qskFramebufferBytes( const QOpenGLFramebufferObject* fbo )
+{
+    const auto format = fbo->format();
+
+    qint64 bytes = qskTextureBytes( fbo->size() ) * qMax( format.samples(), 1 );
+
+    if ( format.attachment() != QOpenGLFramebufferObject::NoAttachment )
+        bytes *= 2; // depth/stencil with 32 bits
+
+    return bytes;
+}
+
+static uint qskAllocateTexture( const QSize& size )
+{
+    auto& f = *QOpenGLContext::currentContext()->functions();
+
+    const auto target = QOpenGLTexture::Target2D;
+
+    GLint oldTexture;
+    f.glGetIntegerv( QOpenGLTexture::BindingTarget2D, &oldTexture );
+
+    GLuint textureId;
+    f.glGenTextures( 1, &textureId );
+
+    f.glBindTexture( target, textureId );
+
+    f.glTexParameteri( target, GL_TEXTURE_MIN_FILTER, QOpenGLTexture::Nearest );
+    f.glTexParameteri( target, GL_TEXTURE_MAG_FILTER, QOpenGLTexture::Nearest );
+
+    f.glTexParameteri( target, GL_TEXTURE_WRAP_S, QOpenGLTexture::ClampToEdge );
+    f.glTexParameteri( target, GL_TEXTURE_WRAP_T, QOpenGLTexture::ClampToEdge );
+
+    f.glTexImage2D( target, 0, QOpenGLTexture::RGBA8_UNorm,
+        size.width(), size.height(), 0,
+        QOpenGLTexture::RGBA, QOpenGLTexture::UInt8, nullptr );
+
+    f.glBindTexture( target, oldTexture );
+
+    return textureId;
+}
+
+static void qskDeleteTexture( uint textureId )
+{
+    // at program termination the context might already be gone
+    if ( auto context = QOpenGLContext::currentContext() )
+    {
+        GLuint id = textureId;
+        context->functions()->glDeleteTextures( 1, &id );
+    }
+}
+
+namespace
+{
+    class UnusedResource
+    {
+      public:
+        // either a texture or a framebuffer
+        uint textureId;
+        QOpenGLFramebufferObject* fbo;
+
+        qint64 bytes;
+    };
+}
+
+class QskTexturePool::PrivateData
+{
+  public:
+    void deleteResource( const UnusedResource& resource )
+    {
+        if ( resource.fbo )
+        {
+            delete resource.fbo;
+        }
+        else
+        {
+            textureSizes.remove( resource.textureId );
+            qskDeleteTexture( resource.textureId );
+        }
+
+        memoryUsage -= resource.bytes;
+    }
+
+    QOpenGLContext* context = nullptr;
+    QMetaObject::Connection connection;
+
+    mutable QMutex mutex;
+
+    // all textures allocated by the pool, that have not been deleted
+    QHash< uint, QSize > textureSizes;
+
+    /*
+        In the order of their release, so that the oldest ones are
+        removed first. As the budget limits the number of entries
+        the list is short enough for a linear lookup.
+     */
+    QVector< UnusedResource > unusedResources;
+
+    qint64 memoryUsage = 0;
+
+    quint64 textureAllocations = 0;
+    quint64 recycledTextures = 0;
+
+    quint64 framebufferAllocations = 0;
+    quint64 recycledFramebuffers = 0;
+
+    quint64 discarded = 0;
+};
+
+QskTexturePool::QskTexturePool()
+    : m_data( new PrivateData() )
+{
+    m_data->context = QOpenGLContext::currentContext();
+}
+
+QskTexturePool::~QskTexturePool()
+{
+    // the pool is recreated, when the window starts rendering again
+    QObject::disconnect( m_data->connection );
+
+    /*
+        Textures, that are still in use, will be deleted
+        by their nodes, when being released.
+     */
+    for ( const auto& resource : qAsConst( m_data->unusedResources ) )
+        m_data->deleteResource( resource );
+}
+
+QskTexturePool* QskTexturePool::pool( QQuickWindow* window )
+{
+    if ( window == nullptr || QOpenGLContext::currentContext() == nullptr )
+        return nullptr;
+
+    const auto renderer = window->rendererInterface();
+    if ( renderer->graphicsApi() != QSGRendererInterface::OpenGL )
+        return nullptr;
+
+    bool isNew;
+    auto pool = qskPoolMap->resource( window, &isNew );
+
+    if ( isNew )
+    {
+        /*
+            With a persistent scene graph the pool survives, when the window
+            stops rendering or releases its resources ( f.e on memory pressure ).
+            Unused resources are dead weight then. The signal is sent from
+            the render thread with the context being current.
+         */
+        pool->m_data->connection = QObject::connect(
+            window, &QQuickWindow::sceneGraphAboutToStop,
+            window, [ window ] { purgeWindow( window ); }, Qt::DirectConnection );
+    }
+
+    return pool;
+}
+
+void QskTexturePool::purgeWindow( const QQuickWindow* window )
+{
+    QMutexLocker locker( qskPoolMap->mutex() );
+
+    if ( auto pool = qskPoolMap->find( window ) )
+        pool->purge();
+}
+
+void QskTexturePool::setMemoryBudget( qint64 bytes )
+{
+    qskMemoryBudget = qMax( bytes, qint64( 0 ) );
+}
+
+qint64 QskTexturePool::memoryBudget()
+{
+    return qskMemoryBudget;
+}
+
+QskTexturePool::Statistics QskTexturePool::globalStatistics()
+{
+    Statistics statistics;
+
+    QMutexLocker locker( qskPoolMap->mutex() );
+
+    const auto pools = qskPoolMap->resources();
+    for ( const auto pool : pools )
+    {
+        const auto s = pool->statistics();
+
+        statistics.textureCount += s.textureCount;
+        statistics.framebufferCount += s.framebufferCount;
+        statistics.memoryUsage += s.memoryUsage;
+        statistics.textureAllocations += s.textureAllocations;
+        statistics.recycledTextures += s.recycledTextures;
+        statistics.framebufferAllocations += s.framebufferAllocations;
+        statistics.recycledFramebuffers += s.recycledFramebuffers;
+        statistics.discarded += s.discarded;
+    }
+
+    return statistics;
+}
+
+void QskTexturePool::releaseTexture( uint textureId )
+{
+    if ( textureId == 0 )
+        return;
+
+    const auto context = QOpenGLContext::currentContext();
+
+    // at program termination the map might already be gone
+    if ( context && !qskPoolMap.isDestroyed() )
+    {
+        QMutexLocker locker( qskPoolMap->mutex() );
+
+        /*
+            Depending on the render loop, windows might share
+            the same context. So we have to find the pool, that
+            has allocated the texture.
+         */
+        const auto pools = qskPoolMap->resources();
+        for ( const auto pool : pools )
+        {
+            if ( pool->m_data->context == context )
+            {
+                if ( pool->recycleTexture( textureId ) )
+                    return;
+            }
+        }
+    }
+
+    qskDeleteTexture( textureId );
+}
+
+uint QskTexturePool::acquireTexture( const QSize& size )
+{
+    if ( size.isEmpty() )
+        return 0;
+
+    QMutexLocker locker( &m_data->mutex );
+
+    auto& resources = m_data->unusedResources;
+
+    for ( int i = resources.count() - 1; i >= 0; i-- )
+    {
+        const auto resource = resources[ i ];
+
+        if ( resource.fbo == nullptr
+            && m_data->textureSizes.value( resource.textureId ) == size )
+        {
+            resources.remove( i );
+
+            m_data->memoryUsage -= resource.bytes;
+            m_data->recycledTextures++;
+
+            return resource.textureId;
+        }
+    }
+
+    const auto textureId = qskAllocateTexture( size );
+
+    m_data->textureSizes.insert( textureId, size );
+    m_data->textureAllocations++;
+
+    return textureId;
+}
+
+bool QskTexturePool::recycleTexture( uint textureId )
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    const auto it = m_data->textureSizes.constFind( textureId );
+    if ( it == m_data->textureSizes.constEnd() )
+        return false;
+
+    const UnusedResource resource { textureId, nullptr, qskTextureBytes( it.value() ) };
+
+    m_data->unusedResources += resource;
+    m_data->memoryUsage += resource.bytes;
+
+    trim( memoryBudget() );
+
+    return true;
+}
+
+QOpenGLFramebufferObject* QskTexturePool::acquireFramebuffer(
+    const QSize& size, const QOpenGLFramebufferObjectFormat& format )
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    auto& resources = m_data->unusedResources;
+
+    for ( int i = resources.count() - 1; i >= 0; i-- )
+    {
+        const auto resource = resources[ i ];
+
+        if ( resource.fbo && resource.fbo->size() == size
+            && resource.fbo->format() == format )
+        {
+            resources.remove( i );
+
+            m_data->memoryUsage -= resource.bytes;
+            m_data->recycledFramebuffers++;
+
+            return resource.fbo;
+        }
+    }
+
+    m_data->framebufferAllocations++;
+
+    return new QOpenGLFramebufferObject( size, format );
+}
+
+void QskTexturePool::releaseFramebuffer( QOpenGLFramebufferObject* fbo )
+{
+    if ( fbo == nullptr )
+        return;
+
+    QMutexLocker locker( &m_data->mutex );
+
+    const UnusedResource resource { 0, fbo, qskFramebufferBytes( fbo ) };
+
+    m_data->unusedResources += resource;
+    m_data->memoryUsage += resource.bytes;
+
+    trim( memoryBudget() );
+}
+
+void QskTexturePool::purge()
+{
+    QMutexLocker locker( &m_data->mutex );
+    trim( 0 );
+}
+
+void QskTexturePool::trim( qint64 budget )
+{
+    // called with locked mutex
+
+    auto& resources = m_data->unusedResources;
+
+    int count = 0;
+    for ( ; count < resources.count() && m_data->memoryUsage > budget; count++ )
+    {
+        m_data->deleteResource( resources[ count ] );
+        m_data->discarded++;
+    }
+
+    if ( count > 0 )
+        resources.remove( 0, count );
+}
+
+QskTexturePool::Statistics QskTexturePool::statistics() const
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    Statistics statistics;
+
+    for ( const auto& resource : qAsConst( m_data->unusedResources ) )
+    {
+        if ( resource.fbo )
+            statistics.framebufferCount++;
+        else
+            statistics.textureCount++;
+    }
+
+    statistics.memoryUsage = m_data->memoryUsage;
+    statistics.textureAllocations = m_data->textureAllocations;
+    statistics.recycledTextures = m_data->recycledTextures;
+    statistics.framebufferAllocations = m_data->framebufferAllocations;
+    statistics.recycledFramebuffers = m_data->recycledFramebuffers;
+    statistics.discarded = m_data->discarded;
+
+    return statistics;
+}
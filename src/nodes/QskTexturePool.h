@@ -0,0 +1,95 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_TEXTURE_POOL_H
+#define QSK_TEXTURE_POOL_H
+
+#include "QskGlobal.h"
+
+#include <qsize.h>
+#include <memory>
+
+class QOpenGLFramebufferObject;
+class QOpenGLFramebufferObjectFormat;
+class QQuickWindow;
+
+/*
+    A per window pool of textures and framebuffer objects, that are
+    not in use anymore. Instead of allocating new resources, nodes that are
+    updated frequently - like painted nodes - recycle them from the pool.
+
+    Resources are bucketed by size and format. Unused resources are deleted
+    in the order of their release, when exceeding the memory budget.
+
+    The pool is purged, when the scene graph of the window is about to stop -
+    f.e. because of QQuickWindow::releaseResources().
+
+    The pool is only available for the OpenGL backend.
+ */
+class QSK_EXPORT QskTexturePool
+{
+  public:
+    class Statistics
+    {
+      public:
+        // unused resources, that are waiting for being recycled
+        int textureCount = 0;
+        int framebufferCount = 0;
+        qint64 memoryUsage = 0; // bytes
+
+        quint64 textureAllocations = 0;
+        quint64 recycledTextures = 0; // = avoided allocations
+
+        quint64 framebufferAllocations = 0;
+        quint64 recycledFramebuffers = 0; // = avoided allocations
+
+        quint64 discarded = 0; // deleted because of the budget
+    };
+
+    QskTexturePool();
+    ~QskTexturePool();
+
+    // nullptr, when not supported by the scene graph backend
+    static QskTexturePool* pool( QQuickWindow* );
+
+    static void setMemoryBudget( qint64 bytes );
+    static qint64 memoryBudget();
+
+    // accumulated over the pools of all windows
+    static Statistics globalStatistics();
+
+    /*
+        Gives a texture back to the pool of the current context. Textures,
+        that have not been allocated from a pool, are deleted.
+     */
+    static void releaseTexture( uint textureId );
+
+    // texture with RGBA8 storage and undefined content
+    uint acquireTexture( const QSize& );
+
+    // the framebuffer might contain the content of a previous use
+    QOpenGLFramebufferObject* acquireFramebuffer(
+        const QSize&, const QOpenGLFramebufferObjectFormat& );
+
+    void releaseFramebuffer( QOpenGLFramebufferObject* );
+
+    // deleting all unused resources
+    void purge();
+
+    Statistics statistics() const;
+
+  private:
+    Q_DISABLE_COPY( QskTexturePool )
+
+    static void purgeWindow( const QQuickWindow* );
+
+    bool recycleTexture( uint textureId );
+    void trim( qint64 budget );
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
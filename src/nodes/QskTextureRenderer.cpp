@@ -7,6 +7,7 @@
 #include "QskColorFilter.h"
 #include "QskGraphic.h"
 #include "QskSetup.h"
+#include "QskTexturePool.h"
 
 #include <qopenglcontext.h>
 #include <qopenglextrafunctions.h>
@@ -17,6 +18,10 @@
 
 #include <qimage.h>
 #include <qpainter.h>
+#include <qrunnable.h>
+#include <qsemaphore.h>
+#include <qthread.h>
+#include <qthreadpool.h>
 
 #include <qquickwindow.h>
 #include <qsgtexture.h>
@@ -25,6 +30,134 @@
     #include <qsgtexture_platform.h>
 #endif
 
+namespace
+{
+    class GraphicPaintHelper : public QskTextureRenderer::PaintHelper
+    {
+      public:
+        GraphicPaintHelper( const QskGraphic& graphic,
+                const QskColorFilter& filter, Qt::AspectRatioMode aspectRatioMode )
+            : m_graphic( graphic )
+            , m_filter( filter )
+            , m_aspectRatioMode( aspectRatioMode )
+        {
+        }
+
+        void paint( QPainter* painter, const QSize& size ) override
+        {
+            const QRect rect( 0, 0, size.width(), size.height() );
+            m_graphic.render( painter, rect, m_filter, m_aspectRatioMode );
+        }
+
+        bool isThreadSafe() const override
+        {
+            // pixmaps can't be used outside of the GUI thread
+            return !( m_graphic.commandTypes() & QskGraphic::RasterData );
+        }
+
+      private:
+        const QskGraphic& m_graphic;
+        const QskColorFilter& m_filter;
+        const Qt::AspectRatioMode m_aspectRatioMode;
+    };
+}
+
+namespace
+{
+    class BandTask : public QRunnable
+    {
+      public:
+        BandTask( QskTextureRenderer::PaintHelper* helper,
+                QImage& image, int y, int height, qreal ratio,
+                const QSize& size, QSemaphore* semaphore )
+            : m_helper( helper )
+            , m_band( image.bits() + y * image.bytesPerLine(),
+                image.width(), height, image.bytesPerLine(), image.format() )
+            , m_y( y )
+            , m_ratio( ratio )
+            , m_size( size )
+            , m_semaphore( semaphore )
+        {
+        }
+
+        void run() override
+        {
+            paint();
+
+            if ( m_semaphore )
+                m_semaphore->release();
+        }
+
+        void paint()
+        {
+            // the band is a view on the lines of the image
+            m_band.fill( Qt::transparent );
+
+            QPainter painter( &m_band );
+
+            painter.translate( 0, -m_y );
+            painter.scale( m_ratio, m_ratio );
+
+            m_helper->paint( &painter, m_size );
+        }
+
+      private:
+        QskTextureRenderer::PaintHelper* m_helper;
+        QImage m_band;
+
+        const int m_y;
+        const qreal m_ratio;
+        const QSize m_size;
+
+        QSemaphore* m_semaphore;
+    };
+}
+
+/*
+    A separate pool, as painting might be initiated from a task, that has
+    been started from the global pool. Waiting for tasks of the same pool
+    might end in a deadlock.
+ */
+Q_GLOBAL_STATIC( QThreadPool, qskBandThreadPool )
+
+static int qskBandCount( const QSize& size,
+    const QskTextureRenderer::PaintHelper* helper )
+{
+    // below these values the overhead of starting the tasks is not worth it
+    const qint64 minPixels = 512 * 512;
+    const int minBandHeight = 64;
+
+    if ( qint64( size.width() ) * size.height() < minPixels )
+        return 1;
+
+    if ( !helper->isThreadSafe() )
+        return 1;
+
+    return qBound( 1, size.height() / minBandHeight, QThread::idealThreadCount() );
+}
+
+static void qskPaintBands( QImage& image, int bandCount,
+    qreal ratio, const QSize& size, QskTextureRenderer::PaintHelper* helper )
+{
+    const int h = image.height();
+
+    QSemaphore semaphore;
+
+    for ( int i = 1; i < bandCount; i++ )
+    {
+        const int y1 = i * h / bandCount;
+        const int y2 = ( i + 1 ) * h / bandCount;
+
+        qskBandThreadPool->start( new BandTask(
+            helper, image, y1, y2 - y1, ratio, size, &semaphore ) );
+    }
+
+    // the first band is painted by the calling thread
+    BandTask( helper, image, 0, h / bandCount, ratio, size, nullptr ).paint();
+
+    semaphore.acquire( bandCount - 1 );
+}
+
 static inline bool qskHasOpenGLRenderer( const QQuickWindow* window )
 {
     if ( window == nullptr )
@@ -34,6 +167,71 @@ static inline bool qskHasOpenGLRenderer( const QQuickWindow* window )
     return renderer->graphicsApi() == QSGRendererInterface::OpenGL;
 }
 
+namespace
+{
+    /*
+        Temporarily replacing the color attachment of a pooled FBO by
+        a pooled texture, so that the result ends up in the texture
+        without having to copy it.
+     */
+    class TextureAttachment
+    {
+      public:
+        TextureAttachment( QOpenGLFramebufferObject* fbo, uint textureId )
+            : m_fbo( fbo )
+        {
+            m_fbo->bind();
+            attach( textureId );
+        }
+
+        ~TextureAttachment()
+        {
+            m_fbo->bind();
+            attach( m_fbo->texture() );
+            m_fbo->release();
+        }
+
+      private:
+        void attach( uint textureId )
+        {
+            auto& f = *QOpenGLContext::currentContext()->functions();
+
+            f.glFramebufferTexture2D( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                QOpenGLTexture::Target2D, textureId, 0 );
+        }
+
+        QOpenGLFramebufferObject* m_fbo;
+    };
+}
+
+static void qskPaintOpenGL( const QSize& fboSize, qreal ratio,
+    const QSize& size, QskTextureRenderer::PaintHelper* helper, bool antialiasing )
+{
+    // into the currently bound FBO
+
+    QOpenGLPaintDevice pd( fboSize.width(), fboSize.height() );
+    pd.setPaintFlipped( true );
+
+    QPainter painter( &pd );
+    painter.scale( ratio, ratio );
+
+    painter.setCompositionMode( QPainter::CompositionMode_Source );
+    painter.fillRect( 0, 0, fboSize.width(), fboSize.height(), Qt::transparent );
+    painter.setCompositionMode( QPainter::CompositionMode_SourceOver );
+
+    helper->paint( &painter, size );
+
+    if ( antialiasing )
+    {
+        /*
+            Multisampling in the window surface might get lost
+            as a side effect of rendering to the FBO.
+            weired, needs to be investigated more
+         */
+        painter.setRenderHint( QPainter::Antialiasing, true );
+    }
+}
+
 static uint qskCreateTextureOpenGL( QQuickWindow* window,
     const QSize& size, QskTextureRenderer::PaintHelper* helper )
 {
@@ -42,59 +240,84 @@ static uint qskCreateTextureOpenGL( QQuickWindow* window,
     const int width = ratio * size.width();
     const int height = ratio * size.height();
 
+    const QSize fboSize( width, height );
+
+    /*
+        Allocating FBOs and textures for each update is expensive. So we recycle
+        them from the pool of the window. As the texture of a FBO can't
+        be taken without allocating a new one on the next bind, the pooled
+        texture is attached to the pooled FBO, while rendering into it.
+     */
+    auto pool = QskTexturePool::pool( window );
+    if ( pool == nullptr )
+        return 0; // only for windows with an OpenGL renderer
+
+    const auto textureId = pool->acquireTexture( fboSize );
+
     QOpenGLFramebufferObjectFormat format1;
     format1.setAttachment( QOpenGLFramebufferObject::CombinedDepthStencil );
 
     // ### TODO: get samples from window instead
     format1.setSamples( QOpenGLContext::currentContext()->format().samples() );
 
-    QOpenGLFramebufferObject multisampledFbo( width, height, format1 );
-
-    QOpenGLPaintDevice pd( width, height );
-    pd.setPaintFlipped( true );
+    auto fbo1 = pool->acquireFramebuffer( fboSize, format1 );
 
+    if ( fbo1->format().samples() > 0 )
     {
-        QPainter painter( &pd );
-        painter.scale( ratio, ratio );
+        fbo1->bind();
+        qskPaintOpenGL( fboSize, ratio, size, helper, true );
+        fbo1->release();
 
-        painter.setCompositionMode( QPainter::CompositionMode_Source );
-        painter.fillRect( 0, 0, width, height, Qt::transparent );
-        painter.setCompositionMode( QPainter::CompositionMode_SourceOver );
+        // resolving the samples directly into the texture
 
-        helper->paint( &painter, size );
+        QOpenGLFramebufferObjectFormat format2;
+        format2.setAttachment( QOpenGLFramebufferObject::NoAttachment );
+
+        auto fbo2 = pool->acquireFramebuffer( fboSize, format2 );
 
-#if 1
-        if ( format1.samples() > 0 )
         {
-            /*
-                Multisampling in the window surface might get lost
-                as a side effect of rendering to the FBO.
-                weired, needs to be investigated more
-             */
-            painter.setRenderHint( QPainter::Antialiasing, true );
-        }
-#endif
-    }
+            const TextureAttachment attachment( fbo2, textureId );
 
-    QOpenGLFramebufferObjectFormat format2;
-    format2.setAttachment( QOpenGLFramebufferObject::NoAttachment );
+            const QRect fboRect( 0, 0, width, height );
 
-    QOpenGLFramebufferObject fbo( width, height, format2 );
+            QOpenGLFramebufferObject::blitFramebuffer(
+                fbo2, fboRect, fbo1, fboRect );
+        }
 
-    const QRect fboRect( 0, 0, width, height );
+        pool->releaseFramebuffer( fbo2 );
+    }
+    else
+    {
+        const TextureAttachment attachment( fbo1, textureId );
+        qskPaintOpenGL( fboSize, ratio, size, helper, false );
+    }
 
-    QOpenGLFramebufferObject::blitFramebuffer(
-        &fbo, fboRect, &multisampledFbo, fboRect );
+    pool->releaseFramebuffer( fbo1 );
 
-    return fbo.takeTexture();
+    return textureId;
 }
 
 static uint qskCreateTextureRaster( QQuickWindow* window,
     const QSize& size, QskTextureRenderer::PaintHelper* helper )
+{
+    const auto image = QskTextureRenderer::createImage( window, size, helper );
+    return QskTextureRenderer::createTextureFromImage( window, image );
+}
+
+QImage QskTextureRenderer::createImage(
+    QQuickWindow* window, const QSize& size, PaintHelper* helper )
 {
     const auto ratio = window ? window->effectiveDevicePixelRatio() : 1.0;
 
     QImage image( size * ratio, QImage::Format_RGBA8888_Premultiplied );
+
+    const int bandCount = qskBandCount( image.size(), helper );
+    if ( bandCount > 1 )
+    {
+        qskPaintBands( image, bandCount, ratio, size, helper );
+        return image;
+    }
+
     image.fill( Qt::transparent );
 
     {
@@ -109,6 +332,17 @@ static uint qskCreateTextureRaster( QQuickWindow* window,
         helper->paint( &painter, size );
     }
 
+    return image;
+}
+
+uint QskTextureRenderer::createTextureFromImage(
+    QQuickWindow* window, const QImage& image )
+{
+    if ( image.isNull() )
+        return 0;
+
+    Q_ASSERT( image.format() == QImage::Format_RGBA8888_Premultiplied );
+
     const auto target = QOpenGLTexture::Target2D;
 
     auto context = QOpenGLContext::currentContext();
@@ -120,6 +354,20 @@ static uint qskCreateTextureRaster( QQuickWindow* window,
     GLint oldTexture; // we can't rely on having OpenGL Direct State Access
     f.glGetIntegerv( QOpenGLTexture::BindingTarget2D, &oldTexture );
 
+    if ( auto pool = QskTexturePool::pool( window ) )
+    {
+        const auto textureId = pool->acquireTexture( image.size() );
+
+        f.glBindTexture( target, textureId );
+
+        f.glTexSubImage2D( target, 0, 0, 0, image.width(), image.height(),
+            QOpenGLTexture::RGBA, QOpenGLTexture::UInt8, image.constBits() );
+
+        f.glBindTexture( target, oldTexture );
+
+        return textureId;
+    }
+
     GLuint textureId;
     f.glGenTextures( 1, &textureId );
 
@@ -152,6 +400,43 @@ static uint qskCreateTextureRaster( QQuickWindow* window,
     return textureId;
 }
 
+void QskTextureRenderer::updateTextureFromImage(
+    uint textureId, const QImage& image, const QRect& rect )
+{
+    const auto r = rect & image.rect();
+
+    auto context = QOpenGLContext::currentContext();
+    if ( textureId == 0 || r.isEmpty() || context == nullptr )
+        return;
+
+    Q_ASSERT( image.format() == QImage::Format_RGBA8888_Premultiplied );
+
+    /*
+        GL_UNPACK_ROW_LENGTH is not available for OpenGL ES 2,
+        so we upload a copy with the stride of the rectangle.
+     */
+    const auto subImage = ( r == image.rect() ) ? image : image.copy( r );
+
+    const auto target = QOpenGLTexture::Target2D;
+
+    auto& f = *context->functions();
+
+    GLint oldTexture;
+    f.glGetIntegerv( QOpenGLTexture::BindingTarget2D, &oldTexture );
+
+    f.glBindTexture( target, textureId );
+
+    f.glTexSubImage2D( target, 0, r.x(), r.y(), r.width(), r.height(),
+        QOpenGLTexture::RGBA, QOpenGLTexture::UInt8, subImage.constBits() );
+
+    f.glBindTexture( target, oldTexture );
+}
+
+bool QskTextureRenderer::PaintHelper::isThreadSafe() const
+{
+    return false;
+}
+
 QSGTexture* QskTextureRenderer::textureFromId(
     QQuickWindow* window, uint textureId, const QSize& size )
 {
@@ -181,9 +466,8 @@ QSGTexture* QskTextureRenderer::textureFromId(
     return texture;
 }
 
-uint QskTextureRenderer::createTexture(
-    QQuickWindow* window, RenderMode renderMode,
-    const QSize& size, PaintHelper* helper )
+QskTextureRenderer::RenderMode QskTextureRenderer::effectiveRenderMode(
+    QQuickWindow* window, RenderMode renderMode )
 {
 #if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
     // Qt6.0.0 is buggy when using FBOs. So let's disable it for the moment TODO ...
@@ -204,7 +488,14 @@ uint QskTextureRenderer::createTexture(
             renderMode = OpenGL;
     }
 
-    if ( renderMode == Raster )
+    return renderMode;
+}
+
+uint QskTextureRenderer::createTexture(
+    QQuickWindow* window, RenderMode renderMode,
+    const QSize& size, PaintHelper* helper )
+{
+    if ( effectiveRenderMode( window, renderMode ) == Raster )
         return qskCreateTextureRaster( window, size, helper );
     else
         return qskCreateTextureOpenGL( window, size, helper );
@@ -215,29 +506,15 @@ uint QskTextureRenderer::createTextureFromGraphic(
     const QskGraphic& graphic, const QskColorFilter& colorFilter,
     Qt::AspectRatioMode aspectRatioMode )
 {
-    class PaintHelper : public QskTextureRenderer::PaintHelper
-    {
-      public:
-        PaintHelper( const QskGraphic& graphic,
-                const QskColorFilter& filter, Qt::AspectRatioMode aspectRatioMode )
-            : m_graphic( graphic )
-            , m_filter( filter )
-            , m_aspectRatioMode( aspectRatioMode )
-        {
-        }
-
-        void paint( QPainter* painter, const QSize& size ) override
-        {
-            const QRect rect( 0, 0, size.width(), size.height() );
-            m_graphic.render( painter, rect, m_filter, m_aspectRatioMode );
-        }
-
-      private:
-        const QskGraphic& m_graphic;
-        const QskColorFilter& m_filter;
-        const Qt::AspectRatioMode m_aspectRatioMode;
-    };
-
-    PaintHelper helper( graphic, colorFilter, aspectRatioMode );
+    GraphicPaintHelper helper( graphic, colorFilter, aspectRatioMode );
     return createTexture( window, renderMode, size, &helper );
 }
+
+QImage QskTextureRenderer::createImageFromGraphic(
+    QQuickWindow* window, const QSize& size,
+    const QskGraphic& graphic, const QskColorFilter& colorFilter,
+    Qt::AspectRatioMode aspectRatioMode )
+{
+    GraphicPaintHelper helper( graphic, colorFilter, aspectRatioMode );
+    return createImage( window, size, &helper );
+}
@@ -13,7 +13,9 @@ class QskGraphic;
 class QskColorFilter;
 
 class QPainter;
+class QImage;
 class QSize;
+class QRect;
 class QSGTexture;
 class QQuickWindow;
 
@@ -43,10 +45,20 @@ namespace QskTextureRenderer
 
         virtual void paint( QPainter*, const QSize& ) = 0;
 
+        /*
+            Large images are painted in horizontal bands in parallel,
+            when paint() can be called from different threads at the same
+            time - each call with its own painter.
+         */
+        virtual bool isThreadSafe() const;
+
       private:
         Q_DISABLE_COPY( PaintHelper )
     };
 
+    // resolving AutoDetect and modes, that are not supported by the backend
+    QSK_EXPORT RenderMode effectiveRenderMode( QQuickWindow*, RenderMode );
+
     QSK_EXPORT uint createTexture(
         QQuickWindow*, RenderMode, const QSize&, PaintHelper* );
 
@@ -54,6 +66,25 @@ namespace QskTextureRenderer
         QQuickWindow*, RenderMode, const QSize&, const QskGraphic&,
         const QskColorFilter&, Qt::AspectRatioMode );
 
+    /*
+        Painting into a QImage with Format_RGBA8888_Premultiplied.
+        See PaintHelper::isThreadSafe()
+     */
+
+    QSK_EXPORT QImage createImage(
+        QQuickWindow*, const QSize&, PaintHelper* );
+
+    QSK_EXPORT QImage createImageFromGraphic(
+        QQuickWindow*, const QSize&, const QskGraphic&,
+        const QskColorFilter&, Qt::AspectRatioMode );
+
+    // recycling a texture from the pool of the window, when possible
+    QSK_EXPORT uint createTextureFromImage( QQuickWindow*, const QImage& );
+
+    // uploading rect of the image into a texture of the same size
+    QSK_EXPORT void updateTextureFromImage(
+        uint textureId, const QImage&, const QRect& );
+
     QSK_EXPORT QSGTexture* textureFromId(
         QQuickWindow*, uint textureId, const QSize& );
 }
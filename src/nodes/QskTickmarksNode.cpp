@@ -22,7 +22,7 @@ class QskTickmarksNodePrivate final : public QSGGeometryNodePrivate
         : geometry( QSGGeometry::defaultAttributes_Point2D(), 0 )
     {
         geometry.setDrawingMode( QSGGeometry::DrawLines );
-        geometry.setVertexDataPattern( QSGGeometry::StaticPattern );
+        geometry.setVertexDataPattern( QSGGeometry::DynamicPattern );
     }
 
     QSGGeometry geometry;
@@ -33,6 +33,7 @@ class QskTickmarksNodePrivate final : public QSGGeometryNodePrivate
 
     QRectF rect;
     int lineWidth = 0;
+    Qt::Orientation orientation = Qt::Horizontal;
 
     QskHashValue hash = 0;
 };
@@ -67,12 +68,22 @@ void QskTickmarksNode::update(
 
     const auto hash = tickmarks.hash( 17435 );
 
-    if( ( hash != d->hash ) || ( rect != d->rect ) )
+    if( ( hash != d->hash ) || ( rect != d->rect )
+        || ( boundaries != d->boundaries ) || ( orientation != d->orientation ) )
     {
         d->hash = hash;
         d->rect = rect;
+        d->boundaries = boundaries;
+        d->orientation = orientation;
+
+        /*
+            When scrolling, the number of ticks usually does not change
+            and we can overwrite the vertexes of the previous update
+         */
+        const int vertexCount = tickmarks.tickCount() * 2;
+        if ( vertexCount != d->geometry.vertexCount() )
+            d->geometry.allocate( vertexCount );
 
-        d->geometry.allocate( tickmarks.tickCount() * 2 );
         auto vertexData = d->geometry.vertexDataAsPoint2D();
 
         const qreal min = boundaries.lowerBound();
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskVectorGraphicNode.h"
+#include "QskColorFilter.h"
+#include "QskGraphic.h"
+#include "QskGraphicTessellator.h"
+
+#include <qglobalstatic.h>
+#include <qsgvertexcolormaterial.h>
+#include <qtransform.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qsgnode_p.h>
+QSK_QT_PRIVATE_END
+
+Q_GLOBAL_STATIC( QSGVertexColorMaterial, qskMaterialVertex )
+
+static inline qreal qskTessellationScale( const QTransform& transform, qreal dpr )
+{
+    /*
+        Rounding up to a power of 2, so that the geometry can be
+        reused, when resizing without a significant change of the size.
+     */
+    const qreal scale = dpr * qMax( qAbs( transform.m11() ), qAbs( transform.m22() ) );
+
+    qreal tessellationScale = 1.0 / 16;
+    while ( tessellationScale < scale )
+        tessellationScale *= 2.0;
+
+    return tessellationScale;
+}
+
+class QskVectorGraphicNodePrivate final : public QSGGeometryNodePrivate
+{
+  public:
+    QskVectorGraphicNodePrivate()
+        : geometry( QSGGeometry::defaultAttributes_ColoredPoint2D(), 0 )
+    {
+        geometry.setDrawingMode( QSGGeometry::DrawTriangles );
+    }
+
+    QSGGeometry geometry;
+
+    QskGraphicTessellator::Triangles triangles;
+    QTransform transform;
+
+    QskHashValue hash = 0;
+};
+
+QskVectorGraphicNode::QskVectorGraphicNode()
+    : QSGGeometryNode( *new QskVectorGraphicNodePrivate )
+{
+    Q_D( QskVectorGraphicNode );
+
+    setGeometry( &d->geometry );
+    setMaterial( qskMaterialVertex );
+}
+
+QskVectorGraphicNode::~QskVectorGraphicNode()
+{
+}
+
+void QskVectorGraphicNode::setGraphic(
+    const QskGraphic& graphic, const QskColorFilter& colorFilter,
+    const QRectF& rect, Qt::Orientations mirrored, qreal devicePixelRatio )
+{
+    Q_D( QskVectorGraphicNode );
+
+    auto transform = graphic.transformation( rect );
+
+    if ( mirrored )
+    {
+        const auto c = rect.center();
+
+        QTransform tr;
+        tr.translate( c.x(), c.y() );
+        tr.scale( ( mirrored & Qt::Horizontal ) ? -1.0 : 1.0,
+            ( mirrored & Qt::Vertical ) ? -1.0 : 1.0 );
+        tr.translate( -c.x(), -c.y() );
+
+        transform *= tr;
+    }
+
+    const auto scale = qskTessellationScale( transform, devicePixelRatio );
+
+    auto hash = graphic.hash( 0 );
+    hash = qHash( colorFilter.substitutions(), hash );
+    hash = qHash( scale, hash );
+
+    const bool isDirty = ( hash != d->hash );
+
+    if ( isDirty )
+    {
+        d->hash = hash;
+        d->triangles = QskGraphicTessellator::triangles( graphic, colorFilter, scale );
+    }
+    else if ( transform == d->transform )
+    {
+        return;
+    }
+
+    d->transform = transform;
+
+    const int count = d->triangles.count();
+
+    if ( count != d->geometry.vertexCount() )
+        d->geometry.allocate( count );
+
+    // mapping is way cheaper than tessellating or rasterizing
+
+    const auto from = d->triangles.constData();
+    auto to = d->geometry.vertexDataAsColoredPoint2D();
+
+    for ( int i = 0; i < count; i++ )
+    {
+        const auto& p = from[ i ];
+
+        qreal x, y;
+        transform.map( p.x, p.y, &x, &y );
+
+        to[ i ] = p;
+        to[ i ].x = x;
+        to[ i ].y = y;
+    }
+
+    markDirty( QSGNode::DirtyGeometry );
+}
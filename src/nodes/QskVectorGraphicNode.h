@@ -0,0 +1,42 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_VECTOR_GRAPHIC_NODE_H
+#define QSK_VECTOR_GRAPHIC_NODE_H
+
+#include "QskGlobal.h"
+
+#include <qnamespace.h>
+#include <qsgnode.h>
+
+class QskGraphic;
+class QskColorFilter;
+class QRectF;
+
+class QskVectorGraphicNodePrivate;
+
+/*
+    Displaying a graphic as colored triangles instead of a texture.
+    As the geometry does not depend on the size, resizing is possible
+    without rasterizing the graphic again.
+
+    Only graphics, that are accepted by QskGraphicTessellator::isSupported
+    can be displayed. Antialiasing depends on multisampling being enabled
+    for the window.
+ */
+class QSK_EXPORT QskVectorGraphicNode : public QSGGeometryNode
+{
+  public:
+    QskVectorGraphicNode();
+    ~QskVectorGraphicNode() override;
+
+    void setGraphic( const QskGraphic&, const QskColorFilter&,
+        const QRectF&, Qt::Orientations mirrored, qreal devicePixelRatio );
+
+  private:
+    Q_DECLARE_PRIVATE( QskVectorGraphicNode )
+};
+
+#endif
@@ -0,0 +1,98 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_WINDOW_RESOURCE_MAP_H
+#define QSK_WINDOW_RESOURCE_MAP_H
+
+#include "QskGlobal.h"
+
+#include <qhash.h>
+#include <qmutex.h>
+#include <qquickwindow.h>
+
+/*
+    Scene graph resources, that are shared between the nodes of a window,
+    like atlas or cached textures. They are created on demand in the render
+    thread and destroyed, when the scene graph of the window gets invalidated.
+
+    Nodes might outlive their resource - f.e at program termination. So
+    before accessing a resource from a node destructor the node has to
+    check, that it is still alive.
+ */
+template< typename T >
+class QskWindowResourceMap
+{
+  public:
+    ~QskWindowResourceMap()
+    {
+        qDeleteAll( m_hash );
+    }
+
+    T* resource( QQuickWindow* window, bool* isNew = nullptr )
+    {
+        QMutexLocker locker( &m_mutex );
+
+        auto it = m_hash.constFind( window );
+        if ( it != m_hash.constEnd() )
+        {
+            if ( isNew )
+                *isNew = false;
+
+            return it.value();
+        }
+
+        if ( isNew )
+            *isNew = true;
+
+        auto resource = new T();
+        m_hash.insert( window, resource );
+
+        QObject::connect( window, &QQuickWindow::sceneGraphInvalidated,
+            window, [ this, window ] { remove( window ); },
+            Qt::DirectConnection );
+
+        return resource;
+    }
+
+    // the mutex has to be locked, as long as the resource is in use
+    inline QMutex* mutex()
+    {
+        return &m_mutex;
+    }
+
+    // nullptr, when no resource has been created for the window
+    T* find( const QQuickWindow* window ) const
+    {
+        return m_hash.value( window, nullptr );
+    }
+
+    bool contains( const T* resource ) const
+    {
+        for ( auto it = m_hash.constBegin(); it != m_hash.constEnd(); ++it )
+        {
+            if ( it.value() == resource )
+                return true;
+        }
+
+        return false;
+    }
+
+    QList< T* > resources() const
+    {
+        return m_hash.values();
+    }
+
+  private:
+    void remove( const QQuickWindow* window )
+    {
+        QMutexLocker locker( &m_mutex );
+        delete m_hash.take( window );
+    }
+
+    QMutex m_mutex;
+    QHash< const QQuickWindow*, T* > m_hash;
+};
+
+#endif
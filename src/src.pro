@@ -97,9 +97,12 @@ HEADERS += \
     nodes/QskArcRenderer.h \
     nodes/QskBoxNode.h \
     nodes/QskBoxClipNode.h \
+    nodes/QskBoxShadowNode.h \
     nodes/QskBoxRenderer.h \
     nodes/QskBoxRendererColorMap.h \
     nodes/QskGraphicNode.h \
+    nodes/QskGraphicTessellator.h \
+    nodes/QskNodePool.h \
     nodes/QskPaintedNode.h \
     nodes/QskPlainTextRenderer.h \
     nodes/QskRichTextRenderer.h \
@@ -107,20 +110,28 @@ HEADERS += \
     nodes/QskSGNode.h \
     nodes/QskTextNode.h \
     nodes/QskTextRenderer.h \
+    nodes/QskTextureAtlas.h \
+    nodes/QskTextureCache.h \
     nodes/QskTextureNode.h \
+    nodes/QskTexturePool.h \
     nodes/QskTextureRenderer.h \
     nodes/QskTickmarksNode.h \
-    nodes/QskVertex.h
+    nodes/QskVectorGraphicNode.h \
+    nodes/QskVertex.h \
+    nodes/QskWindowResourceMap.h
 
 SOURCES += \
     nodes/QskArcNode.cpp \
     nodes/QskArcRenderer.cpp \
     nodes/QskBoxNode.cpp \
     nodes/QskBoxClipNode.cpp \
+    nodes/QskBoxShadowNode.cpp \
     nodes/QskBoxRendererRect.cpp \
     nodes/QskBoxRendererEllipse.cpp \
     nodes/QskBoxRendererDEllipse.cpp \
     nodes/QskGraphicNode.cpp \
+    nodes/QskGraphicTessellator.cpp \
+    nodes/QskNodePool.cpp \
     nodes/QskPaintedNode.cpp \
     nodes/QskPlainTextRenderer.cpp \
     nodes/QskRichTextRenderer.cpp \
@@ -128,9 +139,13 @@ SOURCES += \
     nodes/QskSGNode.cpp \
     nodes/QskTextNode.cpp \
     nodes/QskTextRenderer.cpp \
+    nodes/QskTextureAtlas.cpp \
+    nodes/QskTextureCache.cpp \
     nodes/QskTextureNode.cpp \
+    nodes/QskTexturePool.cpp \
     nodes/QskTextureRenderer.cpp \
     nodes/QskTickmarksNode.cpp \
+    nodes/QskVectorGraphicNode.cpp \
     nodes/QskVertex.cpp
 
 HEADERS += \
@@ -158,6 +173,7 @@ HEADERS += \
     controls/QskGraphicLabelSkinlet.h \
     controls/QskHintAnimator.h \
     controls/QskInputGrabber.h \
+    controls/QskLayerCache.h \
     controls/QskListView.h \
     controls/QskListViewSkinlet.h \
     controls/QskMenu.h \
@@ -213,6 +229,7 @@ HEADERS += \
     controls/QskTextLabel.h \
     controls/QskTextLabelSkinlet.h \
     controls/QskVariantAnimator.h \
+    controls/QskVirtualLinearBox.h \
     controls/QskWindow.h
 
 SOURCES += \
@@ -240,6 +257,7 @@ SOURCES += \
     controls/QskGraphicLabelSkinlet.cpp \
     controls/QskHintAnimator.cpp \
     controls/QskInputGrabber.cpp \
+    controls/QskLayerCache.cpp \
     controls/QskListView.cpp \
     controls/QskListViewSkinlet.cpp \
     controls/QskMenuSkinlet.cpp \
@@ -294,27 +312,34 @@ SOURCES += \
     controls/QskTextLabel.cpp \
     controls/QskTextLabelSkinlet.cpp \
     controls/QskVariantAnimator.cpp \
+    controls/QskVirtualLinearBox.cpp \
     controls/QskWindow.cpp
 
 HEADERS += \
+    layouts/QskFlowBox.h \
+    layouts/QskFlowLayoutEngine.h \
     layouts/QskGridBox.h \
     layouts/QskGridLayoutEngine.h \
     layouts/QskIndexedLayoutBox.h \
     layouts/QskLayoutChain.h \
     layouts/QskLayoutEngine2D.h \
     layouts/QskLayoutMetrics.h \
+    layouts/QskLayoutProfiler.h \
     layouts/QskLinearBox.h \
     layouts/QskLinearLayoutEngine.h \
     layouts/QskStackBoxAnimator.h \
     layouts/QskStackBox.h
 
 SOURCES += \
+    layouts/QskFlowBox.cpp \
+    layouts/QskFlowLayoutEngine.cpp \
     layouts/QskGridBox.cpp \
     layouts/QskGridLayoutEngine.cpp \
     layouts/QskIndexedLayoutBox.cpp \
     layouts/QskLayoutChain.cpp \
     layouts/QskLayoutEngine2D.cpp \
     layouts/QskLayoutMetrics.cpp \
+    layouts/QskLayoutProfiler.cpp \
     layouts/QskLinearBox.cpp \
     layouts/QskLinearLayoutEngine.cpp \
     layouts/QskStackBoxAnimator.cpp \
@@ -0,0 +1,11 @@
+CONFIG += qskexample
+    CONFIG += console
+    CONFIG += testcase
+
+    QT += testlib
+
+    HEADERS += \
+    main.h
+
+    SOURCES += \
+    main.cpp
@@ -0,0 +1,215 @@
+#include "main.h"
+
+#include <QskControl.h>
+#include <QskGridBox.h>
+
+#include <QRandomGenerator>
+
+/*
+    The results of the cell index of the layout engine are compared
+    with a linear scan over all elements.
+ */
+static int linearIndexAt( const QskGridBox* box, int row, int column )
+{
+    for ( int i = 0; i < box->elementCount(); i++ )
+    {
+        if ( box->effectiveGridOfIndex( i ).contains( column, row ) )
+            return i;
+    }
+
+    return -1;
+}
+
+static int linearNextItemIndex( const QskGridBox* box, int row, int column )
+{
+    int next = -1;
+
+    for ( int i = 0; i < box->elementCount(); i++ )
+    {
+        if ( box->itemAtIndex( i ) == nullptr )
+            continue;
+
+        const auto grid = box->gridOfIndex( i );
+
+        const bool isAfter = ( grid.top() > row )
+            || ( grid.top() == row && grid.left() > column );
+
+        if ( !isAfter )
+            continue;
+
+        if ( next >= 0 )
+        {
+            const auto nextGrid = box->gridOfIndex( next );
+
+            if ( nextGrid.top() < grid.top() )
+                continue;
+
+            if ( nextGrid.top() == grid.top() && nextGrid.left() <= grid.left() )
+                continue;
+        }
+
+        next = i;
+    }
+
+    return next;
+}
+
+static int mismatchingCells( const QskGridBox* box )
+{
+    int count = 0;
+
+    for ( int row = -1; row <= box->rowCount(); row++ )
+    {
+        for ( int column = -1; column <= box->columnCount(); column++ )
+        {
+            if ( box->indexAt( row, column ) != linearIndexAt( box, row, column ) )
+                count++;
+        }
+    }
+
+    return count;
+}
+
+static void populate( QskGridBox* box, int rows, int columns, int count,
+    QList< QQuickItem* >* expectedOrder = nullptr )
+{
+    QRandomGenerator generator( count );
+
+    for ( int i = 0; i < count; i++ )
+    {
+        const int row = generator.bounded( rows );
+        const int column = generator.bounded( columns );
+
+        int rowSpan = 1;
+        int columnSpan = 1;
+
+        switch ( generator.bounded( 8 ) )
+        {
+            case 0:
+                rowSpan = 1 + generator.bounded( 10 );
+                break;
+
+            case 1:
+                columnSpan = 1 + generator.bounded( 10 );
+                break;
+
+            case 2:
+                rowSpan = 1 + generator.bounded( 4 );
+                columnSpan = 1 + generator.bounded( 4 );
+                break;
+        }
+
+        if ( generator.bounded( 5 ) == 0 )
+        {
+            box->addSpacer( QSizeF( 5, 5 ), row, column, rowSpan, columnSpan );
+            continue;
+        }
+
+        auto item = new QskControl();
+
+        if ( expectedOrder )
+        {
+            const auto next = box->itemAtIndex(
+                linearNextItemIndex( box, row, column ) );
+
+            const int pos = next ? expectedOrder->indexOf( next ) : -1;
+            if ( pos >= 0 )
+                expectedOrder->insert( pos, item );
+            else
+                expectedOrder->append( item );
+        }
+
+        box->addItem( item, row, column, rowSpan, columnSpan );
+    }
+}
+
+void GridBoxTests::init()
+{
+    box = new QskGridBox();
+}
+
+void GridBoxTests::cleanup()
+{
+    delete box;
+}
+
+void GridBoxTests::indexAt_data()
+{
+    QTest::addColumn< int >( "rows" );
+    QTest::addColumn< int >( "columns" );
+    QTest::addColumn< int >( "count" );
+
+    QTest::newRow( "small" ) << 10 << 10 << 60;
+    QTest::newRow( "dense" ) << 60 << 60 << 1500;
+    QTest::newRow( "sparse" ) << 150 << 60 << 600;
+}
+
+void GridBoxTests::indexAt()
+{
+    QFETCH( int, rows );
+    QFETCH( int, columns );
+    QFETCH( int, count );
+
+    populate( box, rows, columns, count );
+
+    // an element with an unlimited span
+    box->addItem( new QskControl(), rows / 2, 0, 1, -1 );
+
+    QCOMPARE( mismatchingCells( box ), 0 );
+}
+
+void GridBoxTests::removeAt()
+{
+    populate( box, 40, 40, 400 );
+
+    QRandomGenerator generator( 42 );
+
+    while ( box->elementCount() > 0 )
+    {
+        for ( int i = 0; i < 20 && box->elementCount() > 0; i++ )
+        {
+            const auto index = generator.bounded( box->elementCount() );
+
+            auto item = box->itemAtIndex( index );
+            box->removeAt( index );
+
+            delete item;
+        }
+
+        QCOMPARE( mismatchingCells( box ), 0 );
+    }
+
+    QCOMPARE( box->indexAt( 0, 0 ), -1 );
+}
+
+void GridBoxTests::stackingOrder()
+{
+    QList< QQuickItem* > expectedOrder;
+    populate( box, 30, 30, 300, &expectedOrder );
+
+    QCOMPARE( box->childItems(), expectedOrder );
+}
+
+void GridBoxTests::negativePositions()
+{
+    box->addItem( new QskControl(), 0, 0 );
+    const int count = box->elementCount();
+
+    auto item = new QskControl();
+
+    QVERIFY( box->addItem( item, -1, 0 ) < 0 );
+    QVERIFY( box->addItem( item, 0, -1, 2, 2 ) < 0 );
+
+    delete item;
+
+    QVERIFY( box->addSpacer( QSizeF( 10, 10 ), -1, 0 ) < 0 );
+    QVERIFY( box->addSpacer( QSizeF( 10, 10 ), 0, -3, 2, 2 ) < 0 );
+    QVERIFY( box->addRowSpacer( 10, -1 ) < 0 );
+    QVERIFY( box->addColumnSpacer( 10, -1 ) < 0 );
+
+    QCOMPARE( box->elementCount(), count );
+    QCOMPARE( box->indexAt( 0, 0 ), 0 );
+    QCOMPARE( box->indexAt( -1, 0 ), -1 );
+}
+
+#include "moc_main.cpp"
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <qobject.h>
+#include <QtTest/QtTest>
+
+class QskGridBox;
+class GridBoxTests : public QObject
+{
+    Q_OBJECT
+
+    QskGridBox * box;
+  private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void indexAt_data();
+    void indexAt();
+    void removeAt();
+    void stackingOrder();
+    void negativePositions();
+};
+
+QTEST_MAIN(GridBoxTests)
@@ -1,5 +1,6 @@
 TEMPLATE = subdirs
 
 SUBDIRS += \
-    checkboxes
+    checkboxes \
+    gridbox
 